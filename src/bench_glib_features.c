@@ -0,0 +1,2103 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <glib.h>
+#include <glib/gstdio.h>
+
+// Include the library modules under measurement
+#include "test_double_linked_lists.h"
+#include "test_hash_tables.h"
+#include "test_async_queue.h"
+#include "test_gobject_basics.h"
+#include "test_signals_properties.h"
+#include "student_table.h"
+#include "student_map.h"
+#include "task_ring.h"
+#include "task_priority_queue.h"
+#include "task_pool.h"
+#include "task_cache.h"
+#include "task_bounded_queue.h"
+#include "event_log.h"
+#include "timer_wheel.h"
+
+/* =============================================================================
+ * Non-interactive benchmark harness for libglib_features
+ *
+ * Every case drives one library operation headlessly and reports:
+ * - throughput (ops/sec) over the wall-clock time from the start of the
+ *   first measured call to the end of the last, so loop overhead between
+ *   calls counts against it while setup, teardown and per-iteration
+ *   preparation marked with bench_exclude() do not
+ * - per-call latency percentiles (p50/p99, nanoseconds; "-" for
+ *   multi-threaded cases that only measure throughput)
+ * - heap allocations per operation, for cases that can count them
+ * - peak resident set size while the case ran (Linux: the high-water mark is
+ *   reset through /proc/self/clear_refs before each case; "-" elsewhere)
+ *
+ * Library chatter written to stdout (e.g. "[Object] Person instance created")
+ * is redirected to /dev/null while a case runs, so only the report is printed.
+ * ============================================================================= */
+
+/**
+ * Measurement state for a single benchmark case
+ */
+typedef struct {
+    const char *name;
+    guint64 iterations;     /* operations requested */
+    guint64 *samples_ns;    /* per-call latency samples */
+    guint64 n_samples;
+    guint64 n_ops;          /* operations completed (a batch call counts all of them) */
+    guint64 first_ns;       /* start of the first measured call; 0 before it */
+    guint64 last_ns;        /* end of the last measured call */
+    guint64 excluded_ns;    /* preparation between measured calls */
+    double allocs_per_op;   /* heap allocations per operation; < 0 when not counted */
+} BenchRun;
+
+typedef void (*BenchFunc)(BenchRun *run);
+
+/**
+ * Benchmark case description
+ */
+typedef struct {
+    const char *name;
+    guint64 default_iterations;
+    BenchFunc func;
+} BenchCase;
+
+static inline guint64 bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (guint64)ts.tv_sec * 1000000000ULL + (guint64)ts.tv_nsec;
+}
+
+// Extend the measured wall-clock span to cover [start_ns, end_ns]
+static inline void bench_record_span(BenchRun *run, guint64 start_ns, guint64 end_ns) {
+    if (run->first_ns == 0 || start_ns < run->first_ns) {
+        run->first_ns = start_ns;
+    }
+    run->last_ns = MAX(run->last_ns, end_ns);
+}
+
+// Record the latency of one call started at start_ns that completed n_ops operations
+static inline void bench_record_batch(BenchRun *run, guint64 start_ns, guint64 n_ops) {
+    guint64 end = bench_now_ns();
+    if (run->n_samples < run->iterations) {
+        run->samples_ns[run->n_samples++] = end - start_ns;
+    }
+    run->n_ops += n_ops;
+    bench_record_span(run, start_ns, end);
+}
+
+// Record the latency of one operation started at start_ns
+static inline void bench_record(BenchRun *run, guint64 start_ns) {
+    bench_record_batch(run, start_ns, 1);
+}
+
+// Leave the preparation started at start_ns out of the wall-clock span
+static inline void bench_exclude(BenchRun *run, guint64 start_ns) {
+    if (run->first_ns != 0) {
+        run->excluded_ns += bench_now_ns() - start_ns;
+    }
+}
+
+// Record throughput only (multi-threaded cases without per-call samples)
+static inline void bench_record_total(BenchRun *run, guint64 n_ops, guint64 elapsed_ns) {
+    guint64 end = bench_now_ns();
+    run->n_ops += n_ops;
+    bench_record_span(run, end - elapsed_ns, end);
+}
+
+// Restart the peak RSS from the current RSS; FALSE if the kernel does not support it
+static gboolean bench_reset_peak_rss(void) {
+    int fd = open("/proc/self/clear_refs", O_WRONLY);
+    if (fd < 0) {
+        return FALSE;
+    }
+    gboolean reset = write(fd, "5", 1) == 1;
+    close(fd);
+    return reset;
+}
+
+// Peak RSS since the last reset in kilobytes, or -1 if unknown
+static glong bench_peak_rss_kb(void) {
+    FILE *status = fopen("/proc/self/status", "r");
+    if (!status) {
+        return -1;
+    }
+    char line[256];
+    glong peak_kb = -1;
+    while (fgets(line, sizeof(line), status)) {
+        if (strncmp(line, "VmHWM:", 6) == 0) {
+            peak_kb = strtol(line + 6, NULL, 10);
+            break;
+        }
+    }
+    fclose(status);
+    return peak_kb;
+}
+
+static int compare_samples(const void *a, const void *b) {
+    guint64 x = *(const guint64*)a;
+    guint64 y = *(const guint64*)b;
+    return (x > y) - (x < y);
+}
+
+static guint64 bench_percentile(BenchRun *run, double q) {
+    if (run->n_samples == 0) {
+        return 0;
+    }
+    return run->samples_ns[(guint64)((run->n_samples - 1) * q)];
+}
+
+// Silence library output while a case runs; returns the saved stdout fd
+static int bench_stdout_silence(void) {
+    fflush(stdout);
+    int saved = dup(STDOUT_FILENO);
+    int devnull = open("/dev/null", O_WRONLY);
+    if (devnull >= 0) {
+        dup2(devnull, STDOUT_FILENO);
+        close(devnull);
+    }
+    return saved;
+}
+
+static void bench_stdout_restore(int saved) {
+    fflush(stdout);
+    if (saved >= 0) {
+        dup2(saved, STDOUT_FILENO);
+        close(saved);
+    }
+}
+
+/* =============================================================================
+ * Benchmark Cases
+ * ============================================================================= */
+
+static void bench_list_append(BenchRun *run) {
+    GList *list = NULL;
+
+    for (guint64 i = 0; i < run->iterations; i++) {
+        guint64 prepare = bench_now_ns();
+        ListPerson *person = list_person_new("Bench Person", (int)(i % 100), "Bench City");
+        bench_exclude(run, prepare);
+        guint64 t0 = bench_now_ns();
+        list = g_list_append(list, person);
+        bench_record(run, t0);
+    }
+
+    g_list_free_full(list, (GDestroyNotify)list_person_free);
+}
+
+/* GList vs PersonVec comparison at a fixed collection size */
+#define BENCH_PERSON_RECORDS 1000000
+
+static char* bench_person_name(guint64 i, char *buf, gsize size) {
+    snprintf(buf, size, "Person %" G_GUINT64_FORMAT, i);
+    return buf;
+}
+
+static GList* bench_build_person_glist(guint64 n) {
+    GList *list = NULL;
+    char name[32];
+
+    // prepend + reverse is the O(n) way to bulk-load a GList
+    for (guint64 i = 0; i < n; i++) {
+        list = g_list_prepend(list, list_person_new(bench_person_name(i, name, sizeof(name)),
+                                                    (int)(i % 100), "Bench City"));
+    }
+    return g_list_reverse(list);
+}
+
+static PersonVec* bench_build_person_vec(guint64 n) {
+    PersonVec *vec = person_vec_new((guint)n);
+    char name[32];
+
+    for (guint64 i = 0; i < n; i++) {
+        person_vec_append(vec, bench_person_name(i, name, sizeof(name)), (int)(i % 100), "Bench City");
+    }
+    return vec;
+}
+
+static void bench_glist_person_prepend(BenchRun *run) {
+    GList *list = NULL;
+
+    for (guint64 i = 0; i < run->iterations; i++) {
+        guint64 prepare = bench_now_ns();
+        ListPerson *person = list_person_new("Bench Person", (int)(i % 100), "Bench City");
+        bench_exclude(run, prepare);
+        guint64 t0 = bench_now_ns();
+        list = g_list_prepend(list, person);
+        bench_record(run, t0);
+    }
+
+    g_list_free_full(list, (GDestroyNotify)list_person_free);
+}
+
+static void bench_person_vec_append(BenchRun *run) {
+    PersonVec *vec = person_vec_new(0);
+
+    for (guint64 i = 0; i < run->iterations; i++) {
+        guint64 t0 = bench_now_ns();
+        person_vec_append(vec, "Bench Person", (int)(i % 100), "Bench City");
+        bench_record(run, t0);
+    }
+
+    person_vec_free(vec);
+}
+
+static void bench_glist_person_scan(BenchRun *run) {
+    GList *list = bench_build_person_glist(BENCH_PERSON_RECORDS);
+    volatile gint64 total_age = 0;
+
+    for (guint64 i = 0; i < run->iterations; i++) {
+        guint64 t0 = bench_now_ns();
+        gint64 sum = 0;
+        for (GList *l = list; l != NULL; l = l->next) {
+            sum += ((ListPerson*)l->data)->age;
+        }
+        total_age += sum;
+        bench_record(run, t0);
+    }
+
+    g_list_free_full(list, (GDestroyNotify)list_person_free);
+}
+
+static void bench_person_vec_scan(BenchRun *run) {
+    PersonVec *vec = bench_build_person_vec(BENCH_PERSON_RECORDS);
+    volatile gint64 total_age = 0;
+
+    for (guint64 i = 0; i < run->iterations; i++) {
+        guint64 t0 = bench_now_ns();
+        gint64 sum = 0;
+        guint len = person_vec_length(vec);
+        for (guint j = 0; j < len; j++) {
+            sum += person_vec_index(vec, j)->age;
+        }
+        total_age += sum;
+        bench_record(run, t0);
+    }
+
+    person_vec_free(vec);
+}
+
+static void bench_glist_person_find(BenchRun *run) {
+    GList *list = bench_build_person_glist(BENCH_PERSON_RECORDS);
+    char name[32];
+    bench_person_name(BENCH_PERSON_RECORDS - 1, name, sizeof(name));
+
+    for (guint64 i = 0; i < run->iterations; i++) {
+        guint64 t0 = bench_now_ns();
+        GList *found = g_list_find_custom(list, name, find_person_by_name);
+        g_list_position(list, found);
+        bench_record(run, t0);
+    }
+
+    g_list_free_full(list, (GDestroyNotify)list_person_free);
+}
+
+static void bench_person_vec_find(BenchRun *run) {
+    PersonVec *vec = bench_build_person_vec(BENCH_PERSON_RECORDS);
+    char name[32];
+    bench_person_name(BENCH_PERSON_RECORDS - 1, name, sizeof(name));
+
+    for (guint64 i = 0; i < run->iterations; i++) {
+        guint64 t0 = bench_now_ns();
+        person_vec_find_custom(vec, name, find_person_by_name);
+        bench_record(run, t0);
+    }
+
+    person_vec_free(vec);
+}
+
+static void bench_glist_person_sort(BenchRun *run) {
+    GList *list = bench_build_person_glist(BENCH_PERSON_RECORDS);
+    GRand *rand = g_rand_new_with_seed(42);
+
+    for (guint64 i = 0; i < run->iterations; i++) {
+        guint64 prepare = bench_now_ns();
+        for (GList *l = list; l != NULL; l = l->next) {
+            ((ListPerson*)l->data)->age = g_rand_int_range(rand, 0, 100);
+        }
+        bench_exclude(run, prepare);
+        guint64 t0 = bench_now_ns();
+        list = g_list_sort(list, compare_persons_by_age);
+        bench_record(run, t0);
+    }
+
+    g_rand_free(rand);
+    g_list_free_full(list, (GDestroyNotify)list_person_free);
+}
+
+static void bench_person_vec_sort(BenchRun *run) {
+    PersonVec *vec = bench_build_person_vec(BENCH_PERSON_RECORDS);
+    GRand *rand = g_rand_new_with_seed(42);
+
+    for (guint64 i = 0; i < run->iterations; i++) {
+        guint64 prepare = bench_now_ns();
+        for (guint j = 0; j < person_vec_length(vec); j++) {
+            person_vec_index(vec, j)->age = g_rand_int_range(rand, 0, 100);
+        }
+        bench_exclude(run, prepare);
+        guint64 t0 = bench_now_ns();
+        person_vec_sort(vec, compare_persons_by_age);
+        bench_record(run, t0);
+    }
+
+    g_rand_free(rand);
+    person_vec_free(vec);
+}
+
+static void bench_list_person_new(BenchRun *run) {
+    GPtrArray *people = g_ptr_array_new_with_free_func((GDestroyNotify)list_person_free);
+
+    for (guint64 i = 0; i < run->iterations; i++) {
+        guint64 t0 = bench_now_ns();
+        ListPerson *person = list_person_new("Bench Person", (int)(i % 100), "Bench City");
+        bench_record(run, t0);
+        g_ptr_array_add(people, person);
+    }
+
+    g_ptr_array_free(people, TRUE);
+}
+
+static void bench_list_person_new_in_arena(BenchRun *run) {
+    RecordArena *arena = record_arena_new(0);
+
+    for (guint64 i = 0; i < run->iterations; i++) {
+        guint64 t0 = bench_now_ns();
+        list_person_new_in_arena(arena, "Bench Person", (int)(i % 100), "Bench City");
+        bench_record(run, t0);
+    }
+
+    record_arena_free(arena);
+}
+
+static void bench_hash_student_new(BenchRun *run) {
+    GPtrArray *students = g_ptr_array_new_with_free_func((GDestroyNotify)hash_student_free);
+
+    for (guint64 i = 0; i < run->iterations; i++) {
+        guint64 t0 = bench_now_ns();
+        HashStudent *student = hash_student_new("Bench Student", (int)i, 3.5, "Computer Science");
+        bench_record(run, t0);
+        g_ptr_array_add(students, student);
+    }
+
+    g_ptr_array_free(students, TRUE);
+}
+
+static void bench_hash_student_new_in_arena(BenchRun *run) {
+    RecordArena *arena = record_arena_new(0);
+
+    for (guint64 i = 0; i < run->iterations; i++) {
+        guint64 t0 = bench_now_ns();
+        hash_student_new_in_arena(arena, "Bench Student", (int)i, 3.5, "Computer Science");
+        bench_record(run, t0);
+    }
+
+    record_arena_free(arena);
+}
+
+static void bench_queue_task_new(BenchRun *run) {
+    GPtrArray *tasks = g_ptr_array_new_with_free_func((GDestroyNotify)queue_task_free);
+
+    for (guint64 i = 0; i < run->iterations; i++) {
+        guint64 t0 = bench_now_ns();
+        QueueTask *task = queue_task_new((int)i, "Bench task", (int)(i % 3) + 1);
+        bench_record(run, t0);
+        g_ptr_array_add(tasks, task);
+    }
+
+    g_ptr_array_free(tasks, TRUE);
+}
+
+static void bench_queue_task_new_shared(BenchRun *run) {
+    GPtrArray *tasks = g_ptr_array_new_with_free_func((GDestroyNotify)queue_task_free);
+    char *description = g_ref_string_new_intern("Bench task");
+
+    for (guint64 i = 0; i < run->iterations; i++) {
+        guint64 t0 = bench_now_ns();
+        QueueTask *task = queue_task_new_shared((int)i, description, (int)(i % 3) + 1);
+        bench_record(run, t0);
+        g_ptr_array_add(tasks, task);
+    }
+
+    g_ptr_array_free(tasks, TRUE);
+    g_ref_string_release(description);
+}
+
+/* Create, queue, dequeue and free a task carrying a 64 KB description: copied vs shared */
+#define BENCH_LARGE_PAYLOAD (64 * 1024)
+
+static void bench_queue_task_handoff(BenchRun *run, gboolean shared) {
+    GAsyncQueue *queue = g_async_queue_new();
+    char *text = g_malloc(BENCH_LARGE_PAYLOAD);
+    memset(text, 'x', BENCH_LARGE_PAYLOAD - 1);
+    text[BENCH_LARGE_PAYLOAD - 1] = '\0';
+    char *ref_text = g_ref_string_new(text);
+
+    for (guint64 i = 0; i < run->iterations; i++) {
+        guint64 t0 = bench_now_ns();
+        QueueTask *task = shared
+            ? queue_task_new_shared((int)i, ref_text, 1)
+            : queue_task_new((int)i, text, 1);
+        g_async_queue_push(queue, task);
+        queue_task_free((QueueTask*)g_async_queue_pop(queue));
+        bench_record(run, t0);
+    }
+
+    g_ref_string_release(ref_text);
+    g_free(text);
+    g_async_queue_unref(queue);
+}
+
+static void bench_queue_task_handoff_copy_64k(BenchRun *run) {
+    bench_queue_task_handoff(run, FALSE);
+}
+
+static void bench_queue_task_handoff_shared_64k(BenchRun *run) {
+    bench_queue_task_handoff(run, TRUE);
+}
+
+static void bench_queue_task_new_in_arena(BenchRun *run) {
+    RecordArena *arena = record_arena_new(0);
+
+    for (guint64 i = 0; i < run->iterations; i++) {
+        guint64 t0 = bench_now_ns();
+        queue_task_new_in_arena(arena, (int)i, "Bench task", (int)(i % 3) + 1);
+        bench_record(run, t0);
+    }
+
+    record_arena_free(arena);
+}
+
+static void bench_hash_table_add_student(BenchRun *run) {
+    GHashTable *table = g_hash_table_new_full(g_str_hash, g_str_equal, g_free,
+                                              (GDestroyNotify)hash_student_free);
+    char key[32];
+
+    for (guint64 i = 0; i < run->iterations; i++) {
+        guint64 prepare = bench_now_ns();
+        HashStudent *student = hash_student_new("Bench Student", (int)i,
+                                                (double)(i % 40) / 10.0, "Computer Science");
+        snprintf(key, sizeof(key), "student.%" G_GUINT64_FORMAT, i);
+        bench_exclude(run, prepare);
+        guint64 t0 = bench_now_ns();
+        hash_table_add_student(table, key, student);
+        bench_record(run, t0);
+    }
+
+    g_hash_table_destroy(table);
+}
+
+/* Row-oriented GHashTable scan vs columnar StudentTable filters */
+#define BENCH_STUDENT_ROWS 1000000
+
+static const char *bench_majors[] = {
+    "Computer Science", "Mathematics", "Physics", "Chemistry", "Biology", "History"
+};
+
+static void bench_fill_student(guint64 i, double *gpa, const char **major) {
+    *gpa = (double)((i * 7919) % 41) / 10.0;  /* 0.0 .. 4.0 */
+    *major = bench_majors[(i * 31) % G_N_ELEMENTS(bench_majors)];
+}
+
+// Helper function to count high GPA students row by row
+static void count_high_gpa_entry(gpointer key, gpointer value, gpointer user_data) {
+    (void)key;
+    if (((HashStudent*)value)->gpa >= 3.5) {
+        (*(guint*)user_data)++;
+    }
+}
+
+static void bench_hash_table_scan_gpa(BenchRun *run) {
+    GHashTable *table = g_hash_table_new_full(g_str_hash, g_str_equal, g_free,
+                                              (GDestroyNotify)hash_student_free);
+    char key[32];
+
+    for (guint64 i = 0; i < BENCH_STUDENT_ROWS; i++) {
+        double gpa;
+        const char *major;
+        bench_fill_student(i, &gpa, &major);
+        snprintf(key, sizeof(key), "student.%" G_GUINT64_FORMAT, i);
+        hash_table_add_student(table, key, hash_student_new("Bench Student", (int)i, gpa, major));
+    }
+
+    for (guint64 i = 0; i < run->iterations; i++) {
+        guint matches = 0;
+        guint64 t0 = bench_now_ns();
+        g_hash_table_foreach(table, count_high_gpa_entry, &matches);
+        bench_record(run, t0);
+    }
+
+    g_hash_table_destroy(table);
+}
+
+// Helper function to count CS majors with high GPA row by row
+static void count_cs_high_gpa_entry(gpointer key, gpointer value, gpointer user_data) {
+    HashStudent *student = (HashStudent*)value;
+    (void)key;
+    if (student->gpa >= 3.5 && g_strcmp0(student->major, "Computer Science") == 0) {
+        (*(guint*)user_data)++;
+    }
+}
+
+static void bench_hash_table_scan_major_gpa(BenchRun *run) {
+    GHashTable *table = g_hash_table_new_full(g_str_hash, g_str_equal, g_free,
+                                              (GDestroyNotify)hash_student_free);
+    char key[32];
+
+    for (guint64 i = 0; i < BENCH_STUDENT_ROWS; i++) {
+        double gpa;
+        const char *major;
+        bench_fill_student(i, &gpa, &major);
+        snprintf(key, sizeof(key), "student.%" G_GUINT64_FORMAT, i);
+        hash_table_add_student(table, key, hash_student_new("Bench Student", (int)i, gpa, major));
+    }
+
+    for (guint64 i = 0; i < run->iterations; i++) {
+        guint matches = 0;
+        guint64 t0 = bench_now_ns();
+        g_hash_table_foreach(table, count_cs_high_gpa_entry, &matches);
+        bench_record(run, t0);
+    }
+
+    g_hash_table_destroy(table);
+}
+
+static StudentStore* bench_build_student_store(guint64 rows) {
+    StudentStore *store = student_store_new();
+    char key[32];
+
+    for (guint64 i = 0; i < rows; i++) {
+        double gpa;
+        const char *major;
+        bench_fill_student(i, &gpa, &major);
+        snprintf(key, sizeof(key), "student.%" G_GUINT64_FORMAT, i);
+        student_store_add(store, key, hash_student_new("Bench Student", (int)i, gpa, major));
+    }
+    return store;
+}
+
+static void bench_student_store_query_major_gpa(BenchRun *run) {
+    StudentStore *store = bench_build_student_store(BENCH_STUDENT_ROWS);
+
+    for (guint64 i = 0; i < run->iterations; i++) {
+        guint64 t0 = bench_now_ns();
+        GPtrArray *matches = student_store_find_by_major_min_gpa(store, "Computer Science", 3.5);
+        bench_record(run, t0);
+        g_ptr_array_free(matches, TRUE);
+    }
+
+    student_store_free(store);
+}
+
+static void bench_student_store_add(BenchRun *run) {
+    StudentStore *store = student_store_new();
+    char key[32];
+
+    for (guint64 i = 0; i < run->iterations; i++) {
+        double gpa;
+        const char *major;
+        guint64 prepare = bench_now_ns();
+        bench_fill_student(i, &gpa, &major);
+        HashStudent *student = hash_student_new("Bench Student", (int)i, gpa, major);
+        snprintf(key, sizeof(key), "student.%" G_GUINT64_FORMAT, i);
+        bench_exclude(run, prepare);
+        guint64 t0 = bench_now_ns();
+        student_store_add(store, key, student);
+        bench_record(run, t0);
+    }
+
+    student_store_free(store);
+}
+
+static void bench_student_store_remove(BenchRun *run) {
+    StudentStore *store = bench_build_student_store(run->iterations);
+    char key[32];
+
+    for (guint64 i = 0; i < run->iterations; i++) {
+        snprintf(key, sizeof(key), "student.%" G_GUINT64_FORMAT, i);
+        guint64 t0 = bench_now_ns();
+        student_store_remove(store, key);
+        bench_record(run, t0);
+    }
+
+    student_store_free(store);
+}
+
+/* GHashTable vs StudentMap microbenchmark; values are one shared student */
+#define BENCH_MAP_KEYS 10000000
+
+static HashStudent bench_shared_student = { "Bench Student", 1, 3.5, "Computer Science" };
+
+static void bench_ghash_insert(BenchRun *run) {
+    GHashTable *table = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+    char key[32];
+
+    for (guint64 i = 0; i < run->iterations; i++) {
+        snprintf(key, sizeof(key), "student.%" G_GUINT64_FORMAT, i);
+        guint64 t0 = bench_now_ns();
+        hash_table_add_student(table, key, &bench_shared_student);
+        bench_record(run, t0);
+    }
+
+    g_hash_table_destroy(table);
+}
+
+static void bench_student_map_insert(BenchRun *run) {
+    StudentMap *map = student_map_new_full(0, NULL);
+    char key[32];
+
+    for (guint64 i = 0; i < run->iterations; i++) {
+        snprintf(key, sizeof(key), "student.%" G_GUINT64_FORMAT, i);
+        guint64 t0 = bench_now_ns();
+        student_map_add_student(map, key, &bench_shared_student);
+        bench_record(run, t0);
+    }
+
+    student_map_free(map);
+}
+
+static void bench_ghash_lookup(BenchRun *run) {
+    GHashTable *table = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+    char key[32];
+
+    for (guint64 i = 0; i < run->iterations; i++) {
+        snprintf(key, sizeof(key), "student.%" G_GUINT64_FORMAT, i);
+        hash_table_add_student(table, key, &bench_shared_student);
+    }
+
+    // Look keys up in a different order than they were inserted
+    for (guint64 i = 0; i < run->iterations; i++) {
+        snprintf(key, sizeof(key), "student.%" G_GUINT64_FORMAT, (i * 7919) % run->iterations);
+        guint64 t0 = bench_now_ns();
+        g_hash_table_lookup(table, key);
+        bench_record(run, t0);
+    }
+
+    g_hash_table_destroy(table);
+}
+
+static void bench_student_map_lookup(BenchRun *run) {
+    StudentMap *map = student_map_new_full(0, NULL);
+    char key[32];
+
+    for (guint64 i = 0; i < run->iterations; i++) {
+        snprintf(key, sizeof(key), "student.%" G_GUINT64_FORMAT, i);
+        student_map_add_student(map, key, &bench_shared_student);
+    }
+
+    for (guint64 i = 0; i < run->iterations; i++) {
+        snprintf(key, sizeof(key), "student.%" G_GUINT64_FORMAT, (i * 7919) % run->iterations);
+        guint64 t0 = bench_now_ns();
+        student_map_lookup(map, key);
+        bench_record(run, t0);
+    }
+
+    student_map_free(map);
+}
+
+static StudentTable* bench_build_student_table(void) {
+    StudentTable *table = student_table_new(BENCH_STUDENT_ROWS);
+
+    for (guint64 i = 0; i < BENCH_STUDENT_ROWS; i++) {
+        double gpa;
+        const char *major;
+        bench_fill_student(i, &gpa, &major);
+        student_table_append(table, "Bench Student", (int)i, gpa, major);
+    }
+    return table;
+}
+
+static void bench_student_table_filter(BenchRun *run, gboolean by_major, gboolean simd) {
+    StudentTable *table = bench_build_student_table();
+    StudentSelection *selection = student_selection_new(table);
+    volatile guint matches = 0;
+
+    student_table_set_simd_enabled(simd);
+    for (guint64 i = 0; i < run->iterations; i++) {
+        guint64 t0 = bench_now_ns();
+        if (by_major) {
+            student_table_filter_major(table, "Computer Science", selection);
+        } else {
+            student_table_filter_gpa_at_least(table, 3.5, selection);
+        }
+        matches = student_selection_count(selection);
+        bench_record(run, t0);
+    }
+    student_table_set_simd_enabled(TRUE);
+    (void)matches;
+
+    student_selection_free(selection);
+    student_table_free(table);
+}
+
+static void bench_student_table_filter_gpa(BenchRun *run) {
+    bench_student_table_filter(run, FALSE, TRUE);
+}
+
+static void bench_student_table_filter_gpa_scalar(BenchRun *run) {
+    bench_student_table_filter(run, FALSE, FALSE);
+}
+
+static void bench_student_table_filter_major(BenchRun *run) {
+    bench_student_table_filter(run, TRUE, TRUE);
+}
+
+static void bench_student_table_filter_major_scalar(BenchRun *run) {
+    bench_student_table_filter(run, TRUE, FALSE);
+}
+
+static void bench_async_queue_push(BenchRun *run) {
+    GAsyncQueue *queue = g_async_queue_new_full((GDestroyNotify)queue_task_free);
+
+    for (guint64 i = 0; i < run->iterations; i++) {
+        guint64 prepare = bench_now_ns();
+        QueueTask *task = queue_task_new((int)i, "Bench task", (int)(i % 3) + 1);
+        bench_exclude(run, prepare);
+        guint64 t0 = bench_now_ns();
+        g_async_queue_push(queue, task);
+        bench_record(run, t0);
+    }
+
+    g_async_queue_unref(queue);
+}
+
+static void bench_async_queue_pop(BenchRun *run) {
+    GAsyncQueue *queue = g_async_queue_new();
+
+    for (guint64 i = 0; i < run->iterations; i++) {
+        g_async_queue_push(queue, queue_task_new((int)i, "Bench task", (int)(i % 3) + 1));
+    }
+
+    for (guint64 i = 0; i < run->iterations; i++) {
+        guint64 t0 = bench_now_ns();
+        QueueTask *task = (QueueTask*)g_async_queue_pop(queue);
+        bench_record(run, t0);
+        queue_task_free(task);
+    }
+
+    g_async_queue_unref(queue);
+}
+
+/* One producer thread, main thread consuming; per-item vs batched queue calls */
+#define BENCH_QUEUE_BATCH 64
+
+typedef struct {
+    GAsyncQueue *queue;
+    guint64 n_tasks;
+    guint batch_size;
+} BenchProducer;
+
+static gpointer bench_queue_producer(gpointer data) {
+    BenchProducer *producer = (BenchProducer*)data;
+    QueueTask *batch[BENCH_QUEUE_BATCH];
+    guint64 produced = 0;
+
+    while (produced < producer->n_tasks) {
+        guint n = 0;
+        while (n < producer->batch_size && produced < producer->n_tasks) {
+            batch[n++] = queue_task_new((int)produced, "Bench task", (int)(produced % 3) + 1);
+            produced++;
+        }
+        if (producer->batch_size == 1) {
+            g_async_queue_push(producer->queue, batch[0]);
+        } else {
+            task_queue_push_batch(producer->queue, batch, n);
+        }
+    }
+    return NULL;
+}
+
+static void bench_queue_threaded(BenchRun *run, guint batch_size) {
+    GAsyncQueue *queue = g_async_queue_new();
+    BenchProducer producer = { queue, run->iterations, batch_size };
+    QueueTask *batch[BENCH_QUEUE_BATCH];
+    guint64 consumed = 0;
+
+    guint64 t0 = bench_now_ns();
+    GThread *thread = g_thread_new("bench-producer", bench_queue_producer, &producer);
+    while (consumed < run->iterations) {
+        guint n;
+        if (batch_size == 1) {
+            batch[0] = (QueueTask*)g_async_queue_pop(queue);
+            n = 1;
+        } else {
+            n = task_queue_pop_batch(queue, batch, batch_size, -1);
+        }
+        for (guint i = 0; i < n; i++) {
+            queue_task_free(batch[i]);
+        }
+        consumed += n;
+    }
+    g_thread_join(thread);
+    bench_record_total(run, consumed, bench_now_ns() - t0);
+
+    g_async_queue_unref(queue);
+}
+
+static void bench_async_queue_threaded(BenchRun *run) {
+    bench_queue_threaded(run, 1);
+}
+
+static void bench_task_queue_batch_threaded(BenchRun *run) {
+    bench_queue_threaded(run, BENCH_QUEUE_BATCH);
+}
+
+/*
+ * One producer thread creating tasks, main thread freeing them: g_malloc'd
+ * structs vs structs recycled through the task cache. Both share one
+ * description, so the task struct is the only per-task allocation. A bounded
+ * ring keeps the producer from running arbitrarily far ahead of the consumer.
+ */
+#define BENCH_RECYCLE_WARMUP 100000
+#define BENCH_RECYCLE_DEPTH 1024
+
+typedef struct {
+    TaskRing *ring;
+    const char *description;
+    guint64 n_tasks;
+    gboolean cached;
+} BenchRecycleProducer;
+
+static gpointer bench_recycle_producer(gpointer data) {
+    BenchRecycleProducer *producer = (BenchRecycleProducer*)data;
+    for (guint64 i = 0; i < producer->n_tasks; i++) {
+        QueueTask *task = producer->cached
+            ? queue_task_new_cached((int)i, producer->description, 1)
+            : queue_task_new_shared((int)i, producer->description, 1);
+        task_ring_push(producer->ring, task);
+    }
+    return NULL;
+}
+
+static guint64 bench_recycle_pass(TaskRing *ring, const char *description,
+                                  guint64 n_tasks, gboolean cached) {
+    BenchRecycleProducer producer = { ring, description, n_tasks, cached };
+
+    guint64 t0 = bench_now_ns();
+    GThread *thread = g_thread_new("bench-producer", bench_recycle_producer, &producer);
+    for (guint64 i = 0; i < n_tasks; i++) {
+        QueueTask *task = task_ring_pop(ring);
+        if (cached) {
+            queue_task_free_cached(task);
+        } else {
+            queue_task_free(task);
+        }
+    }
+    g_thread_join(thread);
+    return bench_now_ns() - t0;
+}
+
+static void bench_queue_task_recycle(BenchRun *run, gboolean cached) {
+    TaskRing *ring = task_ring_new(BENCH_RECYCLE_DEPTH);
+    char *description = g_ref_string_new_intern("Bench task");
+    QueueTaskCacheStats before, after;
+
+    // Warm-up fills the cache; the measured pass should then allocate nothing
+    bench_recycle_pass(ring, description, BENCH_RECYCLE_WARMUP, cached);
+    queue_task_cache_get_stats(&before);
+    guint64 elapsed = bench_recycle_pass(ring, description, run->iterations, cached);
+    queue_task_cache_get_stats(&after);
+    bench_record_total(run, run->iterations, elapsed);
+
+    // Without the cache every task is exactly one g_malloc()
+    run->allocs_per_op = cached
+        ? (double)(after.allocated - before.allocated) / (double)run->iterations
+        : 1.0;
+
+    queue_task_cache_trim();
+    g_ref_string_release(description);
+    task_ring_free(ring);
+}
+
+static void bench_queue_task_malloc_threaded(BenchRun *run) {
+    bench_queue_task_recycle(run, FALSE);
+}
+
+static void bench_queue_task_cached_threaded(BenchRun *run) {
+    bench_queue_task_recycle(run, TRUE);
+}
+
+/* The module's own load generator: 2 producers x 2 consumers, no per-task work */
+static void bench_task_queue_run_load(BenchRun *run) {
+    GAsyncQueue *queue = g_async_queue_new();
+    TaskRunStats stats;
+    task_run_stats_init(&stats);
+    int per_producer = (int)(run->iterations / 2);
+
+    guint64 t0 = bench_now_ns();
+    task_queue_run_load(NULL, queue, per_producer, 2, 2, NULL, NULL, &stats);
+    bench_record_total(run, (guint64)per_producer * 2, bench_now_ns() - t0);
+
+    task_run_stats_clear(&stats);
+    g_async_queue_unref(queue);
+}
+
+/*
+ * MPMC scaling: N producer and N consumer threads share one transport.
+ * Tasks are preallocated in an arena so only the queue operations are timed.
+ */
+#define BENCH_RING_CAPACITY 1024
+
+typedef struct {
+    const TaskTransport *transport;
+    gpointer queue;
+    QueueTask **tasks;
+    guint64 n_tasks;
+} BenchMpmcWorker;
+
+static gpointer bench_mpmc_producer(gpointer data) {
+    BenchMpmcWorker *worker = (BenchMpmcWorker*)data;
+    for (guint64 i = 0; i < worker->n_tasks; i++) {
+        worker->transport->push(worker->queue, worker->tasks[i]);
+    }
+    return NULL;
+}
+
+static gpointer bench_mpmc_consumer(gpointer data) {
+    BenchMpmcWorker *worker = (BenchMpmcWorker*)data;
+    while (TRUE) {
+        QueueTask *task = worker->transport->pop(worker->queue);
+        if (task->task_id == -1) {
+            break;
+        }
+        task->completed = TRUE;
+    }
+    return NULL;
+}
+
+static void bench_mpmc(BenchRun *run, const TaskTransport *transport, gpointer queue, guint n_threads) {
+    RecordArena *arena = record_arena_new(0);
+    QueueTask **tasks = g_new(QueueTask*, run->iterations);
+    for (guint64 i = 0; i < run->iterations; i++) {
+        tasks[i] = queue_task_new_in_arena(arena, (int)i, "Bench task", (int)(i % 3) + 1);
+    }
+    QueueTask *terminate = queue_task_new_in_arena(arena, -1, "TERMINATE", 0);
+
+    GThread **producers = g_new(GThread*, n_threads);
+    GThread **consumers = g_new(GThread*, n_threads);
+    BenchMpmcWorker *workers = g_new(BenchMpmcWorker, n_threads);
+    BenchMpmcWorker consumer_worker = { transport, queue, NULL, 0 };
+
+    guint64 t0 = bench_now_ns();
+    for (guint i = 0; i < n_threads; i++) {
+        consumers[i] = g_thread_new("bench-consumer", bench_mpmc_consumer, &consumer_worker);
+    }
+    for (guint i = 0; i < n_threads; i++) {
+        guint64 first = run->iterations * i / n_threads;
+        guint64 last = run->iterations * (i + 1) / n_threads;
+        workers[i] = (BenchMpmcWorker){ transport, queue, tasks + first, last - first };
+        producers[i] = g_thread_new("bench-producer", bench_mpmc_producer, &workers[i]);
+    }
+    for (guint i = 0; i < n_threads; i++) {
+        g_thread_join(producers[i]);
+    }
+    // One termination task per consumer, as in the multiple consumers demo
+    for (guint i = 0; i < n_threads; i++) {
+        transport->push(queue, terminate);
+    }
+    for (guint i = 0; i < n_threads; i++) {
+        g_thread_join(consumers[i]);
+    }
+    bench_record_total(run, run->iterations, bench_now_ns() - t0);
+
+    g_free(workers);
+    g_free(consumers);
+    g_free(producers);
+    g_free(tasks);
+    record_arena_free(arena);
+}
+
+static void bench_async_queue_mpmc(BenchRun *run, guint n_threads) {
+    GAsyncQueue *queue = g_async_queue_new();
+    bench_mpmc(run, &async_queue_transport, queue, n_threads);
+    g_async_queue_unref(queue);
+}
+
+static void bench_task_ring_mpmc(BenchRun *run, guint n_threads) {
+    TaskRing *ring = task_ring_new(BENCH_RING_CAPACITY);
+    bench_mpmc(run, &task_ring_transport, ring, n_threads);
+    task_ring_free(ring);
+}
+
+static void bench_priority_queue_mpmc_4(BenchRun *run) {
+    TaskPriorityQueue *queue = task_priority_queue_new();
+    bench_mpmc(run, &task_priority_queue_transport, queue, 4);
+    task_priority_queue_free(queue);
+}
+
+static void bench_bounded_queue_mpmc_4(BenchRun *run) {
+    TaskBoundedQueue *queue = task_bounded_queue_new(BENCH_RING_CAPACITY);
+    bench_mpmc(run, &task_bounded_queue_transport, queue, 4);
+    task_bounded_queue_free(queue);
+}
+
+#define BENCH_MPMC_CASES(n) \
+    static void bench_async_queue_mpmc_##n(BenchRun *run) { bench_async_queue_mpmc(run, n); } \
+    static void bench_task_ring_mpmc_##n(BenchRun *run) { bench_task_ring_mpmc(run, n); }
+
+BENCH_MPMC_CASES(1)
+BENCH_MPMC_CASES(2)
+BENCH_MPMC_CASES(4)
+BENCH_MPMC_CASES(8)
+BENCH_MPMC_CASES(16)
+BENCH_MPMC_CASES(32)
+BENCH_MPMC_CASES(64)
+
+/*
+ * Queueing delay under backlog: one producer floods tasks of priorities 1-3
+ * while the main thread consumes them with a fixed amount of work per task.
+ * p50/p99 report the queueing delay of one priority; ops/sec is the overall
+ * consumer throughput.
+ */
+#define BENCH_DELAY_WORK_SPINS 1000
+
+typedef struct {
+    const TaskTransport *transport;
+    gpointer queue;
+    QueueTask **tasks;
+    guint64 n_tasks;
+    guint64 *enqueued_ns;
+} BenchDelayProducer;
+
+static gpointer bench_delay_producer(gpointer data) {
+    BenchDelayProducer *producer = (BenchDelayProducer*)data;
+    for (guint64 i = 0; i < producer->n_tasks; i++) {
+        producer->enqueued_ns[i] = bench_now_ns();
+        producer->transport->push(producer->queue, producer->tasks[i]);
+    }
+    producer->transport->push(producer->queue, producer->tasks[producer->n_tasks]);
+    return NULL;
+}
+
+static void bench_queue_delay(BenchRun *run, const TaskTransport *transport, gpointer queue, int priority) {
+    RecordArena *arena = record_arena_new(0);
+    QueueTask **tasks = g_new(QueueTask*, run->iterations + 1);
+    guint64 *enqueued_ns = g_new(guint64, run->iterations);
+    for (guint64 i = 0; i < run->iterations; i++) {
+        tasks[i] = queue_task_new_in_arena(arena, (int)i, "Bench task", (int)(i % 3) + 1);
+    }
+    tasks[run->iterations] = queue_task_new_in_arena(arena, -1, "TERMINATE", 0);
+
+    BenchDelayProducer producer = { transport, queue, tasks, run->iterations, enqueued_ns };
+    volatile guint64 work = 0;
+
+    guint64 t0 = bench_now_ns();
+    GThread *thread = g_thread_new("bench-producer", bench_delay_producer, &producer);
+    while (TRUE) {
+        QueueTask *task = transport->pop(queue);
+        if (task->task_id == -1) {
+            break;
+        }
+        if (task->priority == priority) {
+            run->samples_ns[run->n_samples++] = bench_now_ns() - enqueued_ns[task->task_id];
+        }
+        for (int spin = 0; spin < BENCH_DELAY_WORK_SPINS; spin++) {
+            work = work + 1;
+        }
+        task->completed = TRUE;
+    }
+    g_thread_join(thread);
+    bench_record_total(run, run->iterations, bench_now_ns() - t0);
+
+    g_free(enqueued_ns);
+    g_free(tasks);
+    record_arena_free(arena);
+}
+
+static void bench_async_queue_delay_p1(BenchRun *run) {
+    GAsyncQueue *queue = g_async_queue_new();
+    bench_queue_delay(run, &async_queue_transport, queue, 1);
+    g_async_queue_unref(queue);
+}
+
+static void bench_priority_queue_delay(BenchRun *run, int priority) {
+    TaskPriorityQueue *queue = task_priority_queue_new();
+    bench_queue_delay(run, &task_priority_queue_transport, queue, priority);
+    task_priority_queue_free(queue);
+}
+
+static void bench_priority_queue_delay_p1(BenchRun *run) {
+    bench_priority_queue_delay(run, 1);
+}
+
+static void bench_priority_queue_delay_p3(BenchRun *run) {
+    bench_priority_queue_delay(run, 3);
+}
+
+/*
+ * One submitter feeding a fixed amount of work per task to one consumer per
+ * processor: hand-spawned GAsyncQueue consumers vs the work-stealing pool
+ */
+#define BENCH_POOL_WORK_SPINS 200
+
+static inline void bench_pool_work(QueueTask *task) {
+    volatile guint64 work = 0;
+    for (int spin = 0; spin < BENCH_POOL_WORK_SPINS; spin++) {
+        work = work + 1;
+    }
+    task->completed = TRUE;
+}
+
+static gpointer bench_pool_consumer(gpointer data) {
+    GAsyncQueue *queue = (GAsyncQueue*)data;
+    while (TRUE) {
+        QueueTask *task = (QueueTask*)g_async_queue_pop(queue);
+        if (task->task_id == -1) {
+            break;
+        }
+        bench_pool_work(task);
+    }
+    return NULL;
+}
+
+static void bench_pool_task_func(QueueTask *task, gpointer user_data) {
+    (void)user_data;
+    bench_pool_work(task);
+}
+
+static QueueTask** bench_build_pool_tasks(RecordArena *arena, guint64 n) {
+    QueueTask **tasks = g_new(QueueTask*, n);
+    for (guint64 i = 0; i < n; i++) {
+        tasks[i] = queue_task_new_in_arena(arena, (int)i, "Bench task", (int)(i % 3) + 1);
+    }
+    return tasks;
+}
+
+static void bench_async_queue_consumers(BenchRun *run) {
+    RecordArena *arena = record_arena_new(0);
+    QueueTask **tasks = bench_build_pool_tasks(arena, run->iterations);
+    QueueTask *terminate = queue_task_new_in_arena(arena, -1, "TERMINATE", 0);
+    GAsyncQueue *queue = g_async_queue_new();
+    guint n_threads = g_get_num_processors();
+    GThread **consumers = g_new(GThread*, n_threads);
+
+    guint64 t0 = bench_now_ns();
+    for (guint i = 0; i < n_threads; i++) {
+        consumers[i] = g_thread_new("bench-consumer", bench_pool_consumer, queue);
+    }
+    for (guint64 i = 0; i < run->iterations; i++) {
+        g_async_queue_push(queue, tasks[i]);
+    }
+    for (guint i = 0; i < n_threads; i++) {
+        g_async_queue_push(queue, terminate);
+    }
+    for (guint i = 0; i < n_threads; i++) {
+        g_thread_join(consumers[i]);
+    }
+    bench_record_total(run, run->iterations, bench_now_ns() - t0);
+
+    g_free(consumers);
+    g_async_queue_unref(queue);
+    g_free(tasks);
+    record_arena_free(arena);
+}
+
+static void bench_task_pool(BenchRun *run) {
+    RecordArena *arena = record_arena_new(0);
+    QueueTask **tasks = bench_build_pool_tasks(arena, run->iterations);
+
+    guint64 t0 = bench_now_ns();
+    TaskPool *pool = task_pool_new(0, bench_pool_task_func, NULL);
+    for (guint64 i = 0; i < run->iterations; i++) {
+        task_pool_push(pool, tasks[i]);
+    }
+    task_pool_free(pool);
+    bench_record_total(run, run->iterations, bench_now_ns() - t0);
+
+    g_free(tasks);
+    record_arena_free(arena);
+}
+
+static void bench_person_new(BenchRun *run) {
+    for (guint64 i = 0; i < run->iterations; i++) {
+        guint64 t0 = bench_now_ns();
+        Person *person = person_new("Bench Person", 30, "bench@example.com");
+        bench_record(run, t0);
+        g_object_unref(person);
+    }
+}
+
+static void bench_student_new(BenchRun *run) {
+    for (guint64 i = 0; i < run->iterations; i++) {
+        guint64 t0 = bench_now_ns();
+        Student *student = student_new("Bench Student", 20, "bench@university.edu",
+                                       (gint)i + 1, "Computer Science");
+        bench_record(run, t0);
+        g_object_unref(student);
+    }
+}
+
+static void on_bench_deposit(BankAccount *account, gdouble amount, const gchar *description,
+                             gdouble new_balance, guint64 *count) {
+    (void)account; (void)amount; (void)description; (void)new_balance;
+    (*count)++;
+}
+
+static void bench_bank_account_deposit(BenchRun *run) {
+    BankAccount *account = bank_account_new("BENCH-0001", "Bench Owner", 0.0);
+    guint64 deposits_seen = 0;
+    g_signal_connect(account, "deposit", G_CALLBACK(on_bench_deposit), &deposits_seen);
+
+    for (guint64 i = 0; i < run->iterations; i++) {
+        guint64 t0 = bench_now_ns();
+        bank_account_deposit(account, 1.0, "Bench deposit");
+        bench_record(run, t0);
+    }
+
+    g_object_unref(account);
+}
+
+/* Same observed deposits as bank_account_deposit, applied in batches */
+#define BENCH_BATCH_OPS 1000
+
+static void on_bench_batch_applied(BankAccount *account, guint applied, guint rejected,
+                                   gdouble deposited, gdouble withdrawn, gdouble new_balance,
+                                   guint64 *count) {
+    (void)account; (void)rejected; (void)deposited; (void)withdrawn; (void)new_balance;
+    *count += applied;
+}
+
+static void bench_bank_account_apply_batch(BenchRun *run) {
+    BankAccount *account = bank_account_new("BENCH-0004", "Bench Owner", 0.0);
+    guint64 deposits_seen = 0;
+    g_signal_connect(account, "deposit", G_CALLBACK(on_bench_deposit), &deposits_seen);
+    g_signal_connect(account, "batch-applied", G_CALLBACK(on_bench_batch_applied), &deposits_seen);
+
+    BankAccountOp *ops = g_new(BankAccountOp, BENCH_BATCH_OPS);
+    for (guint i = 0; i < BENCH_BATCH_OPS; i++) {
+        ops[i] = (BankAccountOp){ BANK_ACCOUNT_OP_DEPOSIT, 1.0 };
+    }
+
+    for (guint64 done = 0; done < run->iterations; done += BENCH_BATCH_OPS) {
+        gsize n = (gsize)MIN(run->iterations - done, BENCH_BATCH_OPS);
+        guint64 t0 = bench_now_ns();
+        bank_account_apply_batch(account, ops, n);
+        bench_record_batch(run, t0, n);
+    }
+
+    g_free(ops);
+    g_object_unref(account);
+}
+
+// Observed deposits with emission timing enabled: the cost of the instrumentation
+static void bench_bank_account_deposit_timed(BenchRun *run) {
+    BankAccount *account = bank_account_new("BENCH-0003", "Bench Owner", 0.0);
+    guint64 deposits_seen = 0;
+    g_signal_connect(account, "deposit", G_CALLBACK(on_bench_deposit), &deposits_seen);
+    bank_account_set_emit_timing(account, TRUE);
+
+    for (guint64 i = 0; i < run->iterations; i++) {
+        guint64 t0 = bench_now_ns();
+        bank_account_deposit(account, 1.0, "Bench deposit");
+        bench_record(run, t0);
+    }
+
+    g_object_unref(account);
+}
+
+static void bench_bank_account_deposit_unobserved(BenchRun *run) {
+    BankAccount *account = bank_account_new("BENCH-0002", "Bench Owner", 0.0);
+
+    for (guint64 i = 0; i < run->iterations; i++) {
+        guint64 t0 = bench_now_ns();
+        bank_account_deposit(account, 1.0, "Bench deposit");
+        bench_record(run, t0);
+    }
+
+    g_object_unref(account);
+}
+
+/* Scratch directory for event log segments, removed with its segments */
+static gchar* bench_event_log_dir(void) {
+    return g_dir_make_tmp("bench-evlog-XXXXXX", NULL);
+}
+
+static void bench_event_log_remove(gchar *directory) {
+    if (!directory) {
+        return;
+    }
+    gchar **segments = event_log_list_segments(directory, NULL);
+    for (guint i = 0; segments && segments[i]; i++) {
+        g_remove(segments[i]);
+    }
+    g_strfreev(segments);
+    g_rmdir(directory);
+    g_free(directory);
+}
+
+/*
+ * Logged deposits: an EventLogger writing text to /dev/null or binary
+ * records to a scratch directory, from the handler (sync) or from its
+ * writer thread (async)
+ */
+static void bench_bank_account_deposit_logged(BenchRun *run, gboolean async, gboolean binary) {
+    BankAccount *account = bank_account_new("BENCH-0006", "Bench Owner", 0.0);
+    EventLogger *logger = event_logger_new("BenchLogger");
+    gchar *directory = binary ? bench_event_log_dir() : NULL;
+    if (binary) {
+        if (!directory ||
+            !event_logger_set_binary_log(logger, directory, EVENT_LOG_DEFAULT_SEGMENT_BYTES, NULL)) {
+            g_warning("bank_account_deposit_logged: cannot create an event log");
+        }
+    } else if (!event_logger_set_log_file(logger, "/dev/null")) {
+        g_warning("bank_account_deposit_logged: cannot open /dev/null");
+    }
+    if (async) {
+        event_logger_start_async(logger, 4096, 10, EVENT_LOGGER_FULL_BLOCK);
+    }
+    event_logger_connect_to_bank_account(logger, account);
+
+    for (guint64 i = 0; i < run->iterations; i++) {
+        guint64 t0 = bench_now_ns();
+        bank_account_deposit(account, 1.0, "Bench deposit");
+        bench_record(run, t0);
+    }
+
+    g_object_unref(account);
+    g_object_unref(logger);
+    bench_event_log_remove(directory);
+}
+
+static void bench_bank_account_deposit_logged_sync(BenchRun *run) {
+    bench_bank_account_deposit_logged(run, FALSE, FALSE);
+}
+
+static void bench_bank_account_deposit_logged_async(BenchRun *run) {
+    bench_bank_account_deposit_logged(run, TRUE, FALSE);
+}
+
+static void bench_bank_account_deposit_logged_binary(BenchRun *run) {
+    bench_bank_account_deposit_logged(run, TRUE, TRUE);
+}
+
+/*
+ * Binary event log: appending records one at a time, then reading them
+ * back through the mapped segments
+ */
+static void bench_event_record_fill(EventRecord *record, guint64 i) {
+    memset(record, 0, sizeof(EventRecord));
+    record->timestamp_us = (gint64)i;
+    record->kind = (i % 8 == 7) ? EVENT_RECORD_WITHDRAWAL : EVENT_RECORD_DEPOSIT;
+    record->amounts[0] = 1.0;
+    record->amounts[2] = (gdouble)i;
+    g_strlcpy(record->source, "BENCH-0007", sizeof(record->source));
+    g_strlcpy(record->text, "Bench event", sizeof(record->text));
+}
+
+static void bench_event_log_append(BenchRun *run) {
+    gchar *directory = bench_event_log_dir();
+    EventLogWriter *writer = directory
+        ? event_log_writer_new(directory, EVENT_LOG_DEFAULT_SEGMENT_BYTES, NULL)
+        : NULL;
+    if (!writer) {
+        g_warning("event_log_append: cannot create an event log");
+        bench_event_log_remove(directory);
+        return;
+    }
+
+    EventRecord record;
+    for (guint64 i = 0; i < run->iterations; i++) {
+        bench_event_record_fill(&record, i);
+        guint64 t0 = bench_now_ns();
+        event_log_writer_append(writer, &record, 1, NULL);
+        bench_record(run, t0);
+    }
+
+    event_log_writer_free(writer);
+    bench_event_log_remove(directory);
+}
+
+static void bench_event_log_scan(BenchRun *run) {
+    gchar *directory = bench_event_log_dir();
+    EventLogWriter *writer = directory
+        ? event_log_writer_new(directory, EVENT_LOG_DEFAULT_SEGMENT_BYTES, NULL)
+        : NULL;
+    if (!writer) {
+        g_warning("event_log_scan: cannot create an event log");
+        bench_event_log_remove(directory);
+        return;
+    }
+    EventRecord record;
+    for (guint64 i = 0; i < run->iterations; i++) {
+        bench_event_record_fill(&record, i);
+        event_log_writer_append(writer, &record, 1, NULL);
+    }
+    event_log_writer_free(writer);
+
+    // Audit-style pass: net amount over every record
+    guint64 t0 = bench_now_ns();
+    gdouble net = 0.0;
+    guint64 n_records = 0;
+    gchar **segments = event_log_list_segments(directory, NULL);
+    for (guint i = 0; segments && segments[i]; i++) {
+        EventLogSegment *segment = event_log_segment_open(segments[i], NULL);
+        if (!segment) {
+            continue;
+        }
+        EventLogIter iter;
+        const EventRecord *scanned;
+        event_log_iter_init(&iter, segment);
+        while ((scanned = event_log_iter_next(&iter))) {
+            net += scanned->kind == EVENT_RECORD_DEPOSIT ? scanned->amounts[0] : -scanned->amounts[0];
+            n_records++;
+        }
+        event_log_segment_close(segment);
+    }
+    g_strfreev(segments);
+    bench_record_total(run, n_records, bench_now_ns() - t0);
+
+    if (n_records != run->iterations) {
+        g_warning("event_log_scan: read %" G_GUINT64_FORMAT " of %" G_GUINT64_FORMAT " records (net %.2f)",
+                  n_records, run->iterations, net);
+    }
+    bench_event_log_remove(directory);
+}
+
+/*
+ * Ledger scaling: N threads transferring between random pairs of 1M accounts.
+ * No handlers are connected, so this measures the per-account locking.
+ */
+#define BENCH_LEDGER_ACCOUNTS 1000000
+
+typedef struct {
+    BankAccount **accounts;
+    guint64 n_transfers;
+    guint32 rng;
+} BenchTransferWorker;
+
+static inline guint32 bench_xorshift32(guint32 *state) {
+    guint32 x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *state = x;
+}
+
+static gpointer bench_transfer_worker(gpointer data) {
+    BenchTransferWorker *worker = (BenchTransferWorker*)data;
+    for (guint64 i = 0; i < worker->n_transfers; i++) {
+        guint from = bench_xorshift32(&worker->rng) % BENCH_LEDGER_ACCOUNTS;
+        guint to = bench_xorshift32(&worker->rng) % BENCH_LEDGER_ACCOUNTS;
+        if (to == from) {
+            to = (to + 1) % BENCH_LEDGER_ACCOUNTS;
+        }
+        bank_account_transfer(worker->accounts[from], worker->accounts[to], 1.0, "Bench transfer");
+    }
+    return NULL;
+}
+
+static void bench_bank_transfer(BenchRun *run, guint n_threads) {
+    BankAccount **accounts = g_new(BankAccount*, BENCH_LEDGER_ACCOUNTS);
+    for (guint i = 0; i < BENCH_LEDGER_ACCOUNTS; i++) {
+        char number[16];
+        g_snprintf(number, sizeof(number), "ACC-%07u", i);
+        accounts[i] = bank_account_new(number, "Bench Owner", 1000.0);
+    }
+
+    GThread **threads = g_new(GThread*, n_threads);
+    BenchTransferWorker *workers = g_new(BenchTransferWorker, n_threads);
+
+    guint64 t0 = bench_now_ns();
+    for (guint i = 0; i < n_threads; i++) {
+        guint64 first = run->iterations * i / n_threads;
+        guint64 last = run->iterations * (i + 1) / n_threads;
+        workers[i] = (BenchTransferWorker){ accounts, last - first, 0x9e3779b9u * (i + 1) };
+        threads[i] = g_thread_new("bench-ledger", bench_transfer_worker, &workers[i]);
+    }
+    for (guint i = 0; i < n_threads; i++) {
+        g_thread_join(threads[i]);
+    }
+    bench_record_total(run, run->iterations, bench_now_ns() - t0);
+
+    g_free(workers);
+    g_free(threads);
+    for (guint i = 0; i < BENCH_LEDGER_ACCOUNTS; i++) {
+        g_object_unref(accounts[i]);
+    }
+    g_free(accounts);
+}
+
+#define BENCH_TRANSFER_CASES(n) \
+    static void bench_bank_transfer_##n(BenchRun *run) { bench_bank_transfer(run, n); }
+
+BENCH_TRANSFER_CASES(1)
+BENCH_TRANSFER_CASES(2)
+BENCH_TRANSFER_CASES(4)
+BENCH_TRANSFER_CASES(8)
+BENCH_TRANSFER_CASES(16)
+BENCH_TRANSFER_CASES(32)
+BENCH_TRANSFER_CASES(64)
+
+/*
+ * TaskManager at 10M tasks: adds, completions by id, and an O(k) query
+ */
+#define BENCH_TASK_MANAGER_TASKS 10000000
+
+static TaskManager* bench_task_manager_fill(guint64 n_tasks) {
+    TaskManager *manager = task_manager_new("Bench");
+    for (guint64 i = 0; i < n_tasks; i++) {
+        task_manager_add_task(manager, "Bench task", "Benchmark task", (gint)(i % 3) + 1);
+    }
+    return manager;
+}
+
+static void bench_task_manager_add(BenchRun *run) {
+    TaskManager *manager = task_manager_new("Bench");
+
+    for (guint64 i = 0; i < run->iterations; i++) {
+        guint64 t0 = bench_now_ns();
+        task_manager_add_task(manager, "Bench task", "Benchmark task", (gint)(i % 3) + 1);
+        bench_record(run, t0);
+    }
+
+    g_object_unref(manager);
+}
+
+static void bench_task_manager_complete(BenchRun *run) {
+    TaskManager *manager = bench_task_manager_fill(run->iterations);
+
+    for (guint64 i = 0; i < run->iterations; i++) {
+        guint64 t0 = bench_now_ns();
+        task_manager_complete_task(manager, (gint)i + 1);
+        bench_record(run, t0);
+    }
+
+    g_object_unref(manager);
+}
+
+// One query for the pending half of the store; ops = tasks returned
+static void bench_task_manager_pending_query(BenchRun *run) {
+    TaskManager *manager = bench_task_manager_fill(run->iterations);
+    for (guint64 i = 0; i < run->iterations; i += 2) {
+        task_manager_complete_task(manager, (gint)i + 1);
+    }
+
+    guint64 t0 = bench_now_ns();
+    GPtrArray *pending = task_manager_get_pending_tasks(manager);
+    gdouble percentage = task_manager_get_completion_percentage(manager);
+    bench_record_total(run, pending->len, bench_now_ns() - t0);
+
+    if (pending->len != run->iterations / 2) {
+        g_warning("task_manager_pending_query: %u pending tasks (%.1f%% complete)",
+                  pending->len, percentage);
+    }
+    g_ptr_array_unref(pending);
+    g_object_unref(manager);
+}
+
+/*
+ * Counter used as a hot metric with one value-changed listener: a signal
+ * emission per increment, against updates of 1000 increments that are
+ * announced once
+ */
+#define BENCH_COUNTER_UPDATE_SIZE 1000
+
+static void bench_counter_changed(Counter *counter, gint old_value, gint new_value, gpointer user_data) {
+    (void)counter; (void)old_value; (void)new_value;
+    (*(guint64*)user_data)++;
+}
+
+static void bench_counter_increment_observed(BenchRun *run) {
+    guint64 emissions = 0;
+    Counter *counter = counter_new("Bench", 0, 0, G_MAXINT, 1);
+    g_signal_connect(counter, "value-changed", G_CALLBACK(bench_counter_changed), &emissions);
+
+    for (guint64 i = 0; i < run->iterations; i++) {
+        guint64 t0 = bench_now_ns();
+        counter_increment(counter);
+        bench_record(run, t0);
+    }
+
+    g_object_unref(counter);
+}
+
+// Samples are per update of BENCH_COUNTER_UPDATE_SIZE increments
+static void bench_counter_increment_coalesced(BenchRun *run) {
+    guint64 emissions = 0;
+    Counter *counter = counter_new("Bench", 0, 0, G_MAXINT, 1);
+    g_signal_connect(counter, "value-changed", G_CALLBACK(bench_counter_changed), &emissions);
+
+    for (guint64 done = 0; done < run->iterations; done += BENCH_COUNTER_UPDATE_SIZE) {
+        guint64 n = MIN(BENCH_COUNTER_UPDATE_SIZE, run->iterations - done);
+        guint64 t0 = bench_now_ns();
+        counter_begin_update(counter);
+        for (guint64 i = 0; i < n; i++) {
+            counter_increment(counter);
+        }
+        counter_end_update(counter);
+        bench_record_batch(run, t0, n);
+    }
+
+    if ((guint64)counter_get_value(counter) != run->iterations) {
+        g_warning("counter_increment_coalesced: value %d after %" G_GUINT64_FORMAT " increments",
+                  counter_get_value(counter), run->iterations);
+    }
+    g_object_unref(counter);
+}
+
+/*
+ * Timer wheel with 1M timers spread over an hour of 1 ms ticks: O(1)
+ * schedule and cancel, and advancing the hour in 1 s batches
+ */
+#define BENCH_TIMER_HOUR_TICKS (3600 * 1000)
+#define BENCH_TIMER_BATCH_TICKS 1000
+
+static void bench_timer_expired(TimerWheelEntry *entry, gpointer user_data) {
+    (void)entry;
+    (*(guint64*)user_data)++;
+}
+
+static TimerWheelEntry* bench_timer_entries(guint64 n_timers, guint64 **expires_out) {
+    TimerWheelEntry *entries = g_new(TimerWheelEntry, n_timers);
+    guint64 *expires = g_new(guint64, n_timers);
+    GRand *rand = g_rand_new_with_seed(42);
+    for (guint64 i = 0; i < n_timers; i++) {
+        timer_wheel_entry_init(&entries[i]);
+        expires[i] = 1 + (guint64)g_rand_int_range(rand, 0, BENCH_TIMER_HOUR_TICKS);
+    }
+    g_rand_free(rand);
+    *expires_out = expires;
+    return entries;
+}
+
+static void bench_timer_wheel_schedule(BenchRun *run) {
+    guint64 *expires;
+    TimerWheelEntry *entries = bench_timer_entries(run->iterations, &expires);
+    TimerWheel *wheel = timer_wheel_new(0);
+
+    for (guint64 i = 0; i < run->iterations; i++) {
+        guint64 t0 = bench_now_ns();
+        timer_wheel_schedule(wheel, &entries[i], expires[i]);
+        bench_record(run, t0);
+    }
+
+    timer_wheel_free(wheel);
+    g_free(expires);
+    g_free(entries);
+}
+
+static void bench_timer_wheel_cancel(BenchRun *run) {
+    guint64 *expires;
+    TimerWheelEntry *entries = bench_timer_entries(run->iterations, &expires);
+    TimerWheel *wheel = timer_wheel_new(0);
+    for (guint64 i = 0; i < run->iterations; i++) {
+        timer_wheel_schedule(wheel, &entries[i], expires[i]);
+    }
+
+    for (guint64 i = 0; i < run->iterations; i++) {
+        guint64 t0 = bench_now_ns();
+        timer_wheel_cancel(wheel, &entries[i]);
+        bench_record(run, t0);
+    }
+
+    timer_wheel_free(wheel);
+    g_free(expires);
+    g_free(entries);
+}
+
+// Samples are per 1 s batch; ops = timers fired
+static void bench_timer_wheel_advance(BenchRun *run) {
+    guint64 *expires;
+    TimerWheelEntry *entries = bench_timer_entries(run->iterations, &expires);
+    TimerWheel *wheel = timer_wheel_new(0);
+    for (guint64 i = 0; i < run->iterations; i++) {
+        timer_wheel_schedule(wheel, &entries[i], expires[i]);
+    }
+
+    guint64 fired = 0;
+    for (guint64 now = BENCH_TIMER_BATCH_TICKS; now <= BENCH_TIMER_HOUR_TICKS; now += BENCH_TIMER_BATCH_TICKS) {
+        guint64 before = fired;
+        guint64 t0 = bench_now_ns();
+        timer_wheel_advance(wheel, now, bench_timer_expired, &fired);
+        bench_record_batch(run, t0, fired - before);
+    }
+
+    if (fired != run->iterations) {
+        g_warning("timer_wheel_advance: %" G_GUINT64_FORMAT " of %" G_GUINT64_FORMAT " timers fired",
+                  fired, run->iterations);
+    }
+    timer_wheel_free(wheel);
+    g_free(expires);
+    g_free(entries);
+}
+
+// Deadlines over the next hour for every task, processed in 1 s batches
+static void bench_task_manager_deadlines(BenchRun *run) {
+    TaskManager *manager = bench_task_manager_fill(run->iterations);
+    gint64 start_us = g_get_real_time();
+    GRand *rand = g_rand_new_with_seed(42);
+    for (guint64 i = 0; i < run->iterations; i++) {
+        gint64 offset_us = (gint64)g_rand_int_range(rand, 0, BENCH_TIMER_HOUR_TICKS) * 1000;
+        task_manager_set_task_deadline(manager, (gint)i + 1, start_us + 1000 + offset_us);
+    }
+    g_rand_free(rand);
+
+    guint64 fired = 0;
+    gint64 batch_us = BENCH_TIMER_BATCH_TICKS * 1000;
+    for (gint64 now_us = start_us + batch_us; fired < run->iterations; now_us += batch_us) {
+        guint64 t0 = bench_now_ns();
+        guint n = task_manager_process_timers(manager, now_us);
+        bench_record_batch(run, t0, n);
+        fired += n;
+        if (task_manager_get_next_timer_us(manager) < 0) {
+            break;
+        }
+    }
+
+    if (fired != run->iterations) {
+        g_warning("task_manager_deadlines: %" G_GUINT64_FORMAT " of %" G_GUINT64_FORMAT " deadlines passed",
+                  fired, run->iterations);
+    }
+    g_object_unref(manager);
+}
+
+/*
+ * Contended deposits: 8 threads depositing into one unobserved account.
+ * Deposits are a single atomic add, so the threads never block each other;
+ * the final balance is checked to the cent.
+ */
+#define BENCH_DEPOSIT_THREADS 8
+
+typedef struct {
+    BankAccount *account;
+    guint64 n_deposits;
+} BenchDepositWorker;
+
+static gpointer bench_deposit_worker(gpointer data) {
+    BenchDepositWorker *worker = (BenchDepositWorker*)data;
+    for (guint64 i = 0; i < worker->n_deposits; i++) {
+        bank_account_deposit_cents(worker->account, 1, "Bench deposit");
+    }
+    return NULL;
+}
+
+static void bench_bank_deposit_contended(BenchRun *run) {
+    BankAccount *account = bank_account_new("BENCH-0005", "Bench Owner", 0.0);
+    GThread *threads[BENCH_DEPOSIT_THREADS];
+    BenchDepositWorker workers[BENCH_DEPOSIT_THREADS];
+
+    guint64 t0 = bench_now_ns();
+    for (guint i = 0; i < BENCH_DEPOSIT_THREADS; i++) {
+        guint64 first = run->iterations * i / BENCH_DEPOSIT_THREADS;
+        guint64 last = run->iterations * (i + 1) / BENCH_DEPOSIT_THREADS;
+        workers[i] = (BenchDepositWorker){ account, last - first };
+        threads[i] = g_thread_new("bench-deposit", bench_deposit_worker, &workers[i]);
+    }
+    for (guint i = 0; i < BENCH_DEPOSIT_THREADS; i++) {
+        g_thread_join(threads[i]);
+    }
+    bench_record_total(run, run->iterations, bench_now_ns() - t0);
+
+    if (bank_account_get_balance_cents(account) != (gint64)run->iterations) {
+        g_warning("bank_deposit_contended: balance %" G_GINT64_FORMAT " cents, expected %" G_GUINT64_FORMAT,
+                  bank_account_get_balance_cents(account), run->iterations);
+    }
+    g_object_unref(account);
+}
+
+/*
+ * Counter contention: 8 threads incrementing one counter. The plain
+ * Counter needs a mutex around every increment; AtomicCounter uses one CAS
+ * per increment (bounded) or an add to the calling CPU's slot (sharded).
+ * No main loop runs, so the signals stay pending.
+ */
+#define BENCH_COUNTER_THREADS 8
+
+typedef struct {
+    Counter *counter;
+    GMutex *lock;
+    AtomicCounter *atomic_counter;
+    guint64 n_increments;
+} BenchCounterWorker;
+
+static gpointer bench_counter_locked_worker(gpointer data) {
+    BenchCounterWorker *worker = (BenchCounterWorker*)data;
+    for (guint64 i = 0; i < worker->n_increments; i++) {
+        g_mutex_lock(worker->lock);
+        counter_increment(worker->counter);
+        g_mutex_unlock(worker->lock);
+    }
+    return NULL;
+}
+
+static gpointer bench_atomic_counter_worker(gpointer data) {
+    BenchCounterWorker *worker = (BenchCounterWorker*)data;
+    for (guint64 i = 0; i < worker->n_increments; i++) {
+        atomic_counter_increment(worker->atomic_counter);
+    }
+    return NULL;
+}
+
+static void bench_counter_contended(BenchRun *run, BenchCounterWorker *prototype, GThreadFunc func) {
+    GThread *threads[BENCH_COUNTER_THREADS];
+    BenchCounterWorker workers[BENCH_COUNTER_THREADS];
+
+    guint64 t0 = bench_now_ns();
+    for (guint i = 0; i < BENCH_COUNTER_THREADS; i++) {
+        guint64 first = run->iterations * i / BENCH_COUNTER_THREADS;
+        guint64 last = run->iterations * (i + 1) / BENCH_COUNTER_THREADS;
+        workers[i] = *prototype;
+        workers[i].n_increments = last - first;
+        threads[i] = g_thread_new("bench-counter", func, &workers[i]);
+    }
+    for (guint i = 0; i < BENCH_COUNTER_THREADS; i++) {
+        g_thread_join(threads[i]);
+    }
+    bench_record_total(run, run->iterations, bench_now_ns() - t0);
+}
+
+static void bench_counter_increment_locked(BenchRun *run) {
+    GMutex lock;
+    g_mutex_init(&lock);
+    Counter *counter = counter_new("Bench", 0, 0, G_MAXINT, 1);
+    BenchCounterWorker prototype = { counter, &lock, NULL, 0 };
+
+    bench_counter_contended(run, &prototype, bench_counter_locked_worker);
+
+    if ((guint64)counter_get_value(counter) != run->iterations) {
+        g_warning("counter_increment_locked: value %d, expected %" G_GUINT64_FORMAT,
+                  counter_get_value(counter), run->iterations);
+    }
+    g_object_unref(counter);
+    g_mutex_clear(&lock);
+}
+
+static void bench_atomic_counter_check(AtomicCounter *counter, const gchar *name, guint64 expected) {
+    if ((guint64)atomic_counter_get_value(counter) != expected) {
+        g_warning("%s: value %" G_GINT64_FORMAT ", expected %" G_GUINT64_FORMAT,
+                  name, atomic_counter_get_value(counter), expected);
+    }
+}
+
+static void bench_atomic_counter_increment(BenchRun *run) {
+    AtomicCounter *counter = atomic_counter_new("Bench", 0, 0, G_MAXINT64, 1);
+    BenchCounterWorker prototype = { NULL, NULL, counter, 0 };
+
+    bench_counter_contended(run, &prototype, bench_atomic_counter_worker);
+
+    bench_atomic_counter_check(counter, "atomic_counter_increment", run->iterations);
+    g_object_unref(counter);
+}
+
+static void bench_atomic_counter_sharded_increment(BenchRun *run) {
+    AtomicCounter *counter = atomic_counter_new_sharded("Bench", 1);
+    BenchCounterWorker prototype = { NULL, NULL, counter, 0 };
+
+    bench_counter_contended(run, &prototype, bench_atomic_counter_worker);
+
+    bench_atomic_counter_check(counter, "atomic_counter_sharded_increment", run->iterations);
+    g_object_unref(counter);
+}
+
+static const BenchCase bench_cases[] = {
+    { "list_append",                   10000,  bench_list_append },
+    { "glist_person_prepend",          BENCH_PERSON_RECORDS, bench_glist_person_prepend },
+    { "person_vec_append",             BENCH_PERSON_RECORDS, bench_person_vec_append },
+    { "glist_person_scan",             20,     bench_glist_person_scan },
+    { "person_vec_scan",               20,     bench_person_vec_scan },
+    { "glist_person_find",             20,     bench_glist_person_find },
+    { "person_vec_find",               20,     bench_person_vec_find },
+    { "glist_person_sort",             5,      bench_glist_person_sort },
+    { "person_vec_sort",               5,      bench_person_vec_sort },
+    { "list_person_new",               200000, bench_list_person_new },
+    { "list_person_new_in_arena",      200000, bench_list_person_new_in_arena },
+    { "hash_student_new",              200000, bench_hash_student_new },
+    { "hash_student_new_in_arena",     200000, bench_hash_student_new_in_arena },
+    { "queue_task_new",                200000, bench_queue_task_new },
+    { "queue_task_new_shared",         200000, bench_queue_task_new_shared },
+    { "queue_task_new_in_arena",       200000, bench_queue_task_new_in_arena },
+    { "queue_task_handoff_copy_64k",   200000, bench_queue_task_handoff_copy_64k },
+    { "queue_task_handoff_shared_64k", 200000, bench_queue_task_handoff_shared_64k },
+    { "hash_table_add_student",        200000, bench_hash_table_add_student },
+    { "hash_table_scan_gpa",           20,     bench_hash_table_scan_gpa },
+    { "student_table_filter_gpa",      100,    bench_student_table_filter_gpa },
+    { "student_table_filter_gpa_scalar", 100,  bench_student_table_filter_gpa_scalar },
+    { "student_table_filter_major",    100,    bench_student_table_filter_major },
+    { "student_table_filter_major_scalar", 100, bench_student_table_filter_major_scalar },
+    { "hash_table_scan_major_gpa",     20,     bench_hash_table_scan_major_gpa },
+    { "student_store_query_major_gpa", 100,    bench_student_store_query_major_gpa },
+    { "student_store_add",             200000, bench_student_store_add },
+    { "student_store_remove",          200000, bench_student_store_remove },
+    { "ghash_insert",                  BENCH_MAP_KEYS, bench_ghash_insert },
+    { "student_map_insert",            BENCH_MAP_KEYS, bench_student_map_insert },
+    { "ghash_lookup",                  BENCH_MAP_KEYS, bench_ghash_lookup },
+    { "student_map_lookup",            BENCH_MAP_KEYS, bench_student_map_lookup },
+    { "async_queue_push",              200000, bench_async_queue_push },
+    { "async_queue_pop",               200000, bench_async_queue_pop },
+    { "async_queue_threaded",          1000000, bench_async_queue_threaded },
+    { "task_queue_batch_threaded",     1000000, bench_task_queue_batch_threaded },
+    { "queue_task_malloc_threaded",    1000000, bench_queue_task_malloc_threaded },
+    { "queue_task_cached_threaded",    1000000, bench_queue_task_cached_threaded },
+    { "task_queue_run_load",           1000000, bench_task_queue_run_load },
+    { "async_queue_mpmc_1",            1000000, bench_async_queue_mpmc_1 },
+    { "task_ring_mpmc_1",              1000000, bench_task_ring_mpmc_1 },
+    { "async_queue_mpmc_2",            1000000, bench_async_queue_mpmc_2 },
+    { "task_ring_mpmc_2",              1000000, bench_task_ring_mpmc_2 },
+    { "async_queue_mpmc_4",            1000000, bench_async_queue_mpmc_4 },
+    { "task_ring_mpmc_4",              1000000, bench_task_ring_mpmc_4 },
+    { "async_queue_mpmc_8",            1000000, bench_async_queue_mpmc_8 },
+    { "task_ring_mpmc_8",              1000000, bench_task_ring_mpmc_8 },
+    { "async_queue_mpmc_16",           1000000, bench_async_queue_mpmc_16 },
+    { "task_ring_mpmc_16",             1000000, bench_task_ring_mpmc_16 },
+    { "async_queue_mpmc_32",           1000000, bench_async_queue_mpmc_32 },
+    { "task_ring_mpmc_32",             1000000, bench_task_ring_mpmc_32 },
+    { "async_queue_mpmc_64",           1000000, bench_async_queue_mpmc_64 },
+    { "task_ring_mpmc_64",             1000000, bench_task_ring_mpmc_64 },
+    { "priority_queue_mpmc_4",         1000000, bench_priority_queue_mpmc_4 },
+    { "bounded_queue_mpmc_4",          1000000, bench_bounded_queue_mpmc_4 },
+    { "async_queue_delay_p1",          200000, bench_async_queue_delay_p1 },
+    { "priority_queue_delay_p1",       200000, bench_priority_queue_delay_p1 },
+    { "priority_queue_delay_p3",       200000, bench_priority_queue_delay_p3 },
+    { "async_queue_consumers",         1000000, bench_async_queue_consumers },
+    { "task_pool",                     1000000, bench_task_pool },
+    { "person_new",                    100000, bench_person_new },
+    { "student_new",                   100000, bench_student_new },
+    { "bank_account_deposit",          200000, bench_bank_account_deposit },
+    { "bank_account_deposit_timed",    200000, bench_bank_account_deposit_timed },
+    { "bank_account_apply_batch",      200000, bench_bank_account_apply_batch },
+    { "bank_account_deposit_unobserved", 200000, bench_bank_account_deposit_unobserved },
+    { "bank_account_deposit_logged",   200000, bench_bank_account_deposit_logged_sync },
+    { "bank_account_deposit_logged_async", 200000, bench_bank_account_deposit_logged_async },
+    { "bank_account_deposit_logged_binary", 200000, bench_bank_account_deposit_logged_binary },
+    { "event_log_append",              1000000, bench_event_log_append },
+    { "event_log_scan",                1000000, bench_event_log_scan },
+    { "task_manager_add",              BENCH_TASK_MANAGER_TASKS, bench_task_manager_add },
+    { "task_manager_complete",         BENCH_TASK_MANAGER_TASKS, bench_task_manager_complete },
+    { "task_manager_pending_query",    BENCH_TASK_MANAGER_TASKS, bench_task_manager_pending_query },
+    { "counter_increment_observed",    1000000, bench_counter_increment_observed },
+    { "counter_increment_coalesced",   1000000, bench_counter_increment_coalesced },
+    { "timer_wheel_schedule",          1000000, bench_timer_wheel_schedule },
+    { "timer_wheel_cancel",            1000000, bench_timer_wheel_cancel },
+    { "timer_wheel_advance",           1000000, bench_timer_wheel_advance },
+    { "task_manager_deadlines",        1000000, bench_task_manager_deadlines },
+    { "bank_transfer_1",               1000000, bench_bank_transfer_1 },
+    { "bank_transfer_2",               1000000, bench_bank_transfer_2 },
+    { "bank_transfer_4",               1000000, bench_bank_transfer_4 },
+    { "bank_transfer_8",               1000000, bench_bank_transfer_8 },
+    { "bank_transfer_16",              1000000, bench_bank_transfer_16 },
+    { "bank_transfer_32",              1000000, bench_bank_transfer_32 },
+    { "bank_transfer_64",              1000000, bench_bank_transfer_64 },
+    { "bank_deposit_contended_8",      1000000, bench_bank_deposit_contended },
+    { "counter_increment_locked_8",    10000000, bench_counter_increment_locked },
+    { "atomic_counter_increment_8",    10000000, bench_atomic_counter_increment },
+    { "atomic_counter_sharded_increment_8", 10000000, bench_atomic_counter_sharded_increment },
+};
+
+/* =============================================================================
+ * Harness
+ * ============================================================================= */
+
+static gint64 opt_iterations = 0;
+static gchar *opt_filter = NULL;
+static gboolean opt_list = FALSE;
+
+static GOptionEntry bench_entries[] = {
+    { "iterations", 'n', 0, G_OPTION_ARG_INT64, &opt_iterations,
+      "Operations per case (default: per-case)", "N" },
+    { "filter", 'f', 0, G_OPTION_ARG_STRING, &opt_filter,
+      "Only run cases matching the glob PATTERN", "PATTERN" },
+    { "list", 'l', 0, G_OPTION_ARG_NONE, &opt_list,
+      "List available cases and exit", NULL },
+    { NULL, 0, 0, 0, NULL, NULL, NULL }
+};
+
+static void bench_print_header(void) {
+    printf("%-34s %10s %14s %10s %10s %10s %14s\n",
+           "operation", "ops", "ops/sec", "p50 (ns)", "p99 (ns)", "allocs/op", "peak RSS (KB)");
+    printf("%-34s %10s %14s %10s %10s %10s %14s\n",
+           "---------", "---", "-------", "--------", "--------", "---------", "-------------");
+}
+
+static void bench_print_result(BenchRun *run, glong peak_rss_kb) {
+    qsort(run->samples_ns, run->n_samples, sizeof(guint64), compare_samples);
+
+    guint64 wall_ns = run->last_ns - run->first_ns - run->excluded_ns;
+    double ops_per_sec = wall_ns > 0
+        ? (double)run->n_ops * 1e9 / (double)wall_ns
+        : 0.0;
+
+    char p50[24] = "-", p99[24] = "-";
+    if (run->n_samples > 0) {
+        snprintf(p50, sizeof(p50), "%" G_GUINT64_FORMAT, bench_percentile(run, 0.50));
+        snprintf(p99, sizeof(p99), "%" G_GUINT64_FORMAT, bench_percentile(run, 0.99));
+    }
+
+    char allocs[24] = "-";
+    if (run->allocs_per_op >= 0) {
+        snprintf(allocs, sizeof(allocs), "%.4f", run->allocs_per_op);
+    }
+
+    char peak_rss[24] = "-";
+    if (peak_rss_kb >= 0) {
+        snprintf(peak_rss, sizeof(peak_rss), "%ld", peak_rss_kb);
+    }
+
+    printf("%-34s %10" G_GUINT64_FORMAT " %14.0f %10s %10s %10s %14s\n",
+           run->name, run->n_ops, ops_per_sec, p50, p99, allocs, peak_rss);
+}
+
+static void bench_run_case(const BenchCase *bench_case) {
+    BenchRun run = {
+        .name = bench_case->name,
+        .iterations = opt_iterations > 0 ? (guint64)opt_iterations : bench_case->default_iterations,
+        .n_samples = 0,
+        .n_ops = 0,
+        .first_ns = 0,
+        .last_ns = 0,
+        .excluded_ns = 0,
+        .allocs_per_op = -1.0
+    };
+    run.samples_ns = g_new(guint64, run.iterations);
+
+    gboolean rss_reset = bench_reset_peak_rss();
+    int saved_stdout = bench_stdout_silence();
+    bench_case->func(&run);
+    bench_stdout_restore(saved_stdout);
+
+    bench_print_result(&run, rss_reset ? bench_peak_rss_kb() : -1);
+    fflush(stdout);
+    g_free(run.samples_ns);
+}
+
+int main(int argc, char *argv[]) {
+    GError *error = NULL;
+    GOptionContext *context = g_option_context_new("- benchmark libglib_features");
+    g_option_context_add_main_entries(context, bench_entries, NULL);
+
+    if (!g_option_context_parse(context, &argc, &argv, &error)) {
+        fprintf(stderr, "Option parsing failed: %s\n", error->message);
+        g_error_free(error);
+        g_option_context_free(context);
+        return 1;
+    }
+    g_option_context_free(context);
+
+    if (opt_list) {
+        for (gsize i = 0; i < G_N_ELEMENTS(bench_cases); i++) {
+            printf("%s\n", bench_cases[i].name);
+        }
+        return 0;
+    }
+
+    printf("GLib Features Benchmark (GLib %d.%d.%d)\n",
+           glib_major_version, glib_minor_version, glib_micro_version);
+    printf("================================\n\n");
+    bench_print_header();
+
+    for (gsize i = 0; i < G_N_ELEMENTS(bench_cases); i++) {
+        if (opt_filter && !g_pattern_match_simple(opt_filter, bench_cases[i].name)) {
+            continue;
+        }
+        bench_run_case(&bench_cases[i]);
+    }
+
+    g_free(opt_filter);
+    return 0;
+}
@@ -0,0 +1,300 @@
+#include "event_log.h"
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <glib/gstdio.h>
+
+#define EVENT_LOG_SEGMENT_PREFIX "segment-"
+#define EVENT_LOG_SEGMENT_SUFFIX ".evlog"
+
+/* stdio buffer per open segment; records reach the kernel in chunks this big */
+#define EVENT_LOG_WRITE_BUFFER (256 * 1024)
+
+/* The on-disk layout must not depend on the compiler's padding */
+G_STATIC_ASSERT(sizeof(EventLogSegmentHeader) == 32);
+G_STATIC_ASSERT(sizeof(EventRecord) % 8 == 0);
+
+struct _EventLogWriter {
+    gchar *directory;
+    guint64 segment_bytes;
+    guint32 segment_index;      /* index of the open segment */
+    FILE *file;
+    guint64 segment_used;       /* bytes written to the open segment */
+    guint64 n_records;
+};
+
+struct _EventLogSegment {
+    GMappedFile *mapped;
+    const EventLogSegmentHeader *header;
+    const guint8 *records;
+    gsize n_records;
+};
+
+static void set_errno_error(GError **error, int saved_errno, const gchar *action, const gchar *path) {
+    g_set_error(error, G_FILE_ERROR, g_file_error_from_errno(saved_errno),
+                "Cannot %s %s: %s", action, path, g_strerror(saved_errno));
+}
+
+// Parse the index of a segment file name; 0 if it is not one
+static guint32 segment_index_from_name(const gchar *name) {
+    if (!g_str_has_prefix(name, EVENT_LOG_SEGMENT_PREFIX) ||
+        !g_str_has_suffix(name, EVENT_LOG_SEGMENT_SUFFIX)) {
+        return 0;
+    }
+    guint64 index = g_ascii_strtoull(name + strlen(EVENT_LOG_SEGMENT_PREFIX), NULL, 10);
+    return index <= G_MAXUINT32 ? (guint32)index : 0;
+}
+
+static gint compare_paths(gconstpointer a, gconstpointer b) {
+    return strcmp(*(const gchar* const*)a, *(const gchar* const*)b);
+}
+
+gchar** event_log_list_segments(const gchar *directory, GError **error) {
+    g_return_val_if_fail(directory != NULL, NULL);
+
+    GDir *dir = g_dir_open(directory, 0, error);
+    if (!dir) {
+        return NULL;
+    }
+
+    GPtrArray *paths = g_ptr_array_new();
+    const gchar *name;
+    while ((name = g_dir_read_name(dir))) {
+        if (segment_index_from_name(name) > 0) {
+            g_ptr_array_add(paths, g_build_filename(directory, name, NULL));
+        }
+    }
+    g_dir_close(dir);
+
+    // Indexes are zero-padded, so name order is segment order
+    g_ptr_array_sort(paths, compare_paths);
+    g_ptr_array_add(paths, NULL);
+    return (gchar**)g_ptr_array_free(paths, FALSE);
+}
+
+/* =============================================================================
+ * Writer
+ * ============================================================================= */
+
+static gboolean event_log_writer_close_segment(EventLogWriter *writer, GError **error) {
+    if (!writer->file) {
+        return TRUE;
+    }
+
+    int failed = fclose(writer->file);
+    int saved_errno = errno;
+    writer->file = NULL;
+    if (failed != 0) {
+        gchar *path = g_strdup_printf("segment %u in %s", writer->segment_index, writer->directory);
+        set_errno_error(error, saved_errno, "close", path);
+        g_free(path);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+static gboolean event_log_writer_open_segment(EventLogWriter *writer, guint32 index, GError **error) {
+    gchar *name = g_strdup_printf(EVENT_LOG_SEGMENT_PREFIX "%08u" EVENT_LOG_SEGMENT_SUFFIX, index);
+    gchar *path = g_build_filename(writer->directory, name, NULL);
+    g_free(name);
+
+    // "x": never truncate an existing segment
+    FILE *file = fopen(path, "wbx");
+    if (!file) {
+        set_errno_error(error, errno, "create", path);
+        g_free(path);
+        return FALSE;
+    }
+    setvbuf(file, NULL, _IOFBF, EVENT_LOG_WRITE_BUFFER);
+
+    EventLogSegmentHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, EVENT_LOG_MAGIC, sizeof(EVENT_LOG_MAGIC));
+    header.version = EVENT_LOG_VERSION;
+    header.header_size = sizeof(EventLogSegmentHeader);
+    header.record_size = sizeof(EventRecord);
+    header.byte_order = EVENT_LOG_BYTE_ORDER;
+    header.segment_index = index;
+    header.created_us = g_get_real_time();
+
+    if (fwrite(&header, sizeof(header), 1, file) != 1) {
+        set_errno_error(error, errno, "write", path);
+        fclose(file);
+        g_free(path);
+        return FALSE;
+    }
+
+    g_free(path);
+    writer->file = file;
+    writer->segment_index = index;
+    writer->segment_used = sizeof(header);
+    return TRUE;
+}
+
+EventLogWriter* event_log_writer_new(const gchar *directory, guint64 segment_bytes, GError **error) {
+    g_return_val_if_fail(directory != NULL, NULL);
+    g_return_val_if_fail(segment_bytes >= sizeof(EventLogSegmentHeader) + sizeof(EventRecord), NULL);
+
+    if (g_mkdir_with_parents(directory, 0755) != 0) {
+        set_errno_error(error, errno, "create directory", directory);
+        return NULL;
+    }
+
+    gchar **segments = event_log_list_segments(directory, error);
+    if (!segments) {
+        return NULL;
+    }
+    guint32 last = 0;
+    guint n_segments = g_strv_length(segments);
+    if (n_segments > 0) {
+        gchar *name = g_path_get_basename(segments[n_segments - 1]);
+        last = segment_index_from_name(name);
+        g_free(name);
+    }
+    g_strfreev(segments);
+
+    EventLogWriter *writer = g_new0(EventLogWriter, 1);
+    writer->directory = g_strdup(directory);
+    writer->segment_bytes = segment_bytes;
+
+    if (!event_log_writer_open_segment(writer, last + 1, error)) {
+        event_log_writer_free(writer);
+        return NULL;
+    }
+    return writer;
+}
+
+void event_log_writer_free(EventLogWriter *writer) {
+    if (writer) {
+        event_log_writer_close_segment(writer, NULL);
+        g_free(writer->directory);
+        g_free(writer);
+    }
+}
+
+gboolean event_log_writer_append(EventLogWriter *writer, const EventRecord *records,
+                                 gsize n_records, GError **error) {
+    g_return_val_if_fail(writer != NULL, FALSE);
+    g_return_val_if_fail(records != NULL || n_records == 0, FALSE);
+
+    while (n_records > 0) {
+        if (!writer->file) {
+            g_set_error(error, G_FILE_ERROR, G_FILE_ERROR_FAILED,
+                        "Event log in %s is closed after an earlier error", writer->directory);
+            return FALSE;
+        }
+
+        // Rotate when not even one more record fits
+        guint64 room = (writer->segment_bytes - writer->segment_used) / sizeof(EventRecord);
+        if (room == 0) {
+            guint32 next = writer->segment_index + 1;
+            if (!event_log_writer_close_segment(writer, error) ||
+                !event_log_writer_open_segment(writer, next, error)) {
+                return FALSE;
+            }
+            continue;
+        }
+
+        gsize n = (gsize)MIN(room, (guint64)n_records);
+        if (fwrite(records, sizeof(EventRecord), n, writer->file) != n) {
+            set_errno_error(error, errno, "write to", writer->directory);
+            event_log_writer_close_segment(writer, NULL);
+            return FALSE;
+        }
+        writer->segment_used += n * sizeof(EventRecord);
+        writer->n_records += n;
+        records += n;
+        n_records -= n;
+    }
+    return TRUE;
+}
+
+gboolean event_log_writer_flush(EventLogWriter *writer, GError **error) {
+    g_return_val_if_fail(writer != NULL, FALSE);
+
+    if (writer->file && fflush(writer->file) != 0) {
+        set_errno_error(error, errno, "flush", writer->directory);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+guint64 event_log_writer_get_n_records(EventLogWriter *writer) {
+    g_return_val_if_fail(writer != NULL, 0);
+    return writer->n_records;
+}
+
+/* =============================================================================
+ * Reader
+ * ============================================================================= */
+
+EventLogSegment* event_log_segment_open(const gchar *path, GError **error) {
+    g_return_val_if_fail(path != NULL, NULL);
+
+    GMappedFile *mapped = g_mapped_file_new(path, FALSE, error);
+    if (!mapped) {
+        return NULL;
+    }
+
+    const guint8 *data = (const guint8*)g_mapped_file_get_contents(mapped);
+    gsize length = g_mapped_file_get_length(mapped);
+    const EventLogSegmentHeader *header = (const EventLogSegmentHeader*)(const void*)data;
+
+    const gchar *problem = NULL;
+    if (length < sizeof(EventLogSegmentHeader) ||
+        memcmp(header->magic, EVENT_LOG_MAGIC, sizeof(EVENT_LOG_MAGIC)) != 0) {
+        problem = "not an event log segment";
+    } else if (header->byte_order != EVENT_LOG_BYTE_ORDER) {
+        problem = "written with a different byte order";
+    } else if (header->version != EVENT_LOG_VERSION) {
+        problem = "unsupported version";
+    } else if (header->header_size < sizeof(EventLogSegmentHeader) || header->header_size % 8 != 0 ||
+               header->header_size > length ||
+               header->record_size < sizeof(EventRecord) || header->record_size % 8 != 0) {
+        problem = "corrupt header";
+    }
+    if (problem) {
+        g_set_error(error, G_FILE_ERROR, G_FILE_ERROR_INVAL, "%s: %s", path, problem);
+        g_mapped_file_unref(mapped);
+        return NULL;
+    }
+
+    EventLogSegment *segment = g_new(EventLogSegment, 1);
+    segment->mapped = mapped;
+    segment->header = header;
+    segment->records = data + header->header_size;
+    segment->n_records = (length - header->header_size) / header->record_size;
+    return segment;
+}
+
+void event_log_segment_close(EventLogSegment *segment) {
+    if (segment) {
+        g_mapped_file_unref(segment->mapped);
+        g_free(segment);
+    }
+}
+
+const EventLogSegmentHeader* event_log_segment_get_header(EventLogSegment *segment) {
+    g_return_val_if_fail(segment != NULL, NULL);
+    return segment->header;
+}
+
+gsize event_log_segment_get_n_records(EventLogSegment *segment) {
+    g_return_val_if_fail(segment != NULL, 0);
+    return segment->n_records;
+}
+
+const EventRecord* event_log_segment_get_record(EventLogSegment *segment, gsize index) {
+    g_return_val_if_fail(segment != NULL, NULL);
+    g_return_val_if_fail(index < segment->n_records, NULL);
+    return (const EventRecord*)(const void*)(segment->records + index * segment->header->record_size);
+}
+
+void event_log_iter_init(EventLogIter *iter, EventLogSegment *segment) {
+    g_return_if_fail(iter != NULL);
+    g_return_if_fail(segment != NULL);
+
+    iter->next = segment->records;
+    iter->stride = segment->header->record_size;
+    iter->end = segment->records + segment->n_records * iter->stride;
+}
@@ -0,0 +1,125 @@
+#ifndef EVENT_LOG_H
+#define EVENT_LOG_H
+
+#include <glib.h>
+#include "test_signals_properties.h"
+
+/**
+ * Append-only binary event log.
+ *
+ * Events are stored as fixed-size EventRecords in a directory of segment
+ * files named segment-00000001.evlog, segment-00000002.evlog, ... Each
+ * segment starts with an EventLogSegmentHeader followed by the records.
+ * A writer only ever creates new segments and appends to its current one;
+ * the record count is derived from the file size, so a torn record at the
+ * end of a crashed segment is simply ignored.
+ *
+ * Readers map a segment with GMappedFile and hand out pointers straight
+ * into the mapping, so iterating a segment copies nothing. Records are
+ * stored in the writer's byte order, which the header records.
+ *
+ * Versioning: a reader accepts segments of its own version and any record
+ * size at least sizeof(EventRecord). Later versions may only add fields to
+ * the end of the record.
+ */
+#define EVENT_LOG_MAGIC "GEVTLOG"
+#define EVENT_LOG_VERSION 1
+#define EVENT_LOG_BYTE_ORDER 0x01020304u
+
+/* Default segment size limit, header included */
+#define EVENT_LOG_DEFAULT_SEGMENT_BYTES (64 * 1024 * 1024)
+
+typedef struct {
+    gchar magic[8];             /* EVENT_LOG_MAGIC, NUL-terminated */
+    guint16 version;            /* EVENT_LOG_VERSION */
+    guint16 header_size;        /* offset of the first record */
+    guint32 record_size;        /* stride between records, a multiple of 8 */
+    guint32 byte_order;         /* EVENT_LOG_BYTE_ORDER as written by the writer */
+    guint32 segment_index;
+    gint64 created_us;          /* g_get_real_time() when the segment was created */
+} EventLogSegmentHeader;
+
+/* =============================================================================
+ * Writer
+ * ============================================================================= */
+
+typedef struct _EventLogWriter EventLogWriter;
+
+/**
+ * Create directory if needed and start a new segment after the last
+ * existing one. Segments are closed and a new one started once they would
+ * exceed segment_bytes. Not thread-safe: serialize appends externally.
+ */
+EventLogWriter* event_log_writer_new(const gchar *directory, guint64 segment_bytes, GError **error);
+
+/**
+ * Close the current segment, flushing buffered records
+ */
+void event_log_writer_free(EventLogWriter *writer);
+
+/**
+ * Append n_records records. Records are buffered; a failed write leaves
+ * the writer unusable.
+ */
+gboolean event_log_writer_append(EventLogWriter *writer, const EventRecord *records,
+                                 gsize n_records, GError **error);
+
+/**
+ * Hand buffered records to the operating system
+ */
+gboolean event_log_writer_flush(EventLogWriter *writer, GError **error);
+
+guint64 event_log_writer_get_n_records(EventLogWriter *writer);
+
+/* =============================================================================
+ * Reader
+ * ============================================================================= */
+
+typedef struct _EventLogSegment EventLogSegment;
+
+/**
+ * Map a segment read-only and validate its header
+ */
+EventLogSegment* event_log_segment_open(const gchar *path, GError **error);
+void event_log_segment_close(EventLogSegment *segment);
+
+const EventLogSegmentHeader* event_log_segment_get_header(EventLogSegment *segment);
+gsize event_log_segment_get_n_records(EventLogSegment *segment);
+
+/**
+ * Pointer into the mapping; valid until the segment is closed
+ */
+const EventRecord* event_log_segment_get_record(EventLogSegment *segment, gsize index);
+
+/**
+ * Zero-copy cursor over the records of one segment:
+ *
+ *     EventLogIter iter;
+ *     const EventRecord *record;
+ *     event_log_iter_init(&iter, segment);
+ *     while ((record = event_log_iter_next(&iter))) { ... }
+ */
+typedef struct {
+    const guint8 *next;
+    const guint8 *end;
+    gsize stride;
+} EventLogIter;
+
+void event_log_iter_init(EventLogIter *iter, EventLogSegment *segment);
+
+static inline const EventRecord* event_log_iter_next(EventLogIter *iter) {
+    if (iter->next >= iter->end) {
+        return NULL;
+    }
+    const EventRecord *record = (const EventRecord*)(const void*)iter->next;
+    iter->next += iter->stride;
+    return record;
+}
+
+/**
+ * Paths of the segments in directory, oldest first (NULL-terminated, free
+ * with g_strfreev)
+ */
+gchar** event_log_list_segments(const gchar *directory, GError **error);
+
+#endif /* EVENT_LOG_H */
@@ -0,0 +1,104 @@
+#include "record_arena.h"
+#include <stddef.h>
+#include <string.h>
+
+#define RECORD_ARENA_DEFAULT_BLOCK_SIZE (64 * 1024)
+#define RECORD_ARENA_ALIGNMENT _Alignof(max_align_t)
+
+typedef struct _ArenaBlock {
+    struct _ArenaBlock *next;
+    gsize size;
+    gsize used;
+    max_align_t data[];
+} ArenaBlock;
+
+struct _RecordArena {
+    ArenaBlock *first;
+    ArenaBlock *current;
+    gsize block_size;
+    gsize bytes_used;
+    guint block_count;
+};
+
+static ArenaBlock* arena_block_new(gsize size) {
+    ArenaBlock *block = g_malloc(sizeof(ArenaBlock) + size);
+    block->next = NULL;
+    block->size = size;
+    block->used = 0;
+    return block;
+}
+
+RecordArena* record_arena_new(gsize block_size) {
+    RecordArena *arena = g_malloc(sizeof(RecordArena));
+    arena->block_size = block_size > 0 ? block_size : RECORD_ARENA_DEFAULT_BLOCK_SIZE;
+    arena->first = arena_block_new(arena->block_size);
+    arena->current = arena->first;
+    arena->bytes_used = 0;
+    arena->block_count = 1;
+    return arena;
+}
+
+void record_arena_free(RecordArena *arena) {
+    if (arena) {
+        ArenaBlock *block = arena->first;
+        while (block) {
+            ArenaBlock *next = block->next;
+            g_free(block);
+            block = next;
+        }
+        g_free(arena);
+    }
+}
+
+void record_arena_reset(RecordArena *arena) {
+    g_return_if_fail(arena != NULL);
+
+    for (ArenaBlock *block = arena->first; block != NULL; block = block->next) {
+        block->used = 0;
+    }
+    arena->current = arena->first;
+    arena->bytes_used = 0;
+}
+
+gpointer record_arena_alloc(RecordArena *arena, gsize size) {
+    g_return_val_if_fail(arena != NULL, NULL);
+
+    // Round up so the next allocation stays aligned (block data is aligned)
+    gsize aligned_size = (size + RECORD_ARENA_ALIGNMENT - 1) & ~(gsize)(RECORD_ARENA_ALIGNMENT - 1);
+    ArenaBlock *block = arena->current;
+
+    // Skip to the next block with enough room, appending one if needed
+    while (block->used + aligned_size > block->size) {
+        if (!block->next) {
+            block->next = arena_block_new(MAX(arena->block_size, aligned_size));
+            arena->block_count++;
+        }
+        block = block->next;
+    }
+    arena->current = block;
+
+    gpointer ptr = (guint8*)block->data + block->used;
+    block->used += aligned_size;
+    arena->bytes_used += aligned_size;
+    return ptr;
+}
+
+char* record_arena_strdup(RecordArena *arena, const char *str) {
+    if (!str) {
+        return NULL;
+    }
+    gsize len = strlen(str) + 1;
+    char *copy = record_arena_alloc(arena, len);
+    memcpy(copy, str, len);
+    return copy;
+}
+
+gsize record_arena_get_bytes_used(RecordArena *arena) {
+    g_return_val_if_fail(arena != NULL, 0);
+    return arena->bytes_used;
+}
+
+guint record_arena_get_block_count(RecordArena *arena) {
+    g_return_val_if_fail(arena != NULL, 0);
+    return arena->block_count;
+}
@@ -0,0 +1,48 @@
+#ifndef RECORD_ARENA_H
+#define RECORD_ARENA_H
+
+#include <glib.h>
+
+/**
+ * Bump-pointer arena for bulk-loaded records.
+ *
+ * Records built in an arena keep their struct and strings in one contiguous
+ * allocation. They are never freed individually: the whole batch is released
+ * at once with record_arena_reset() or record_arena_free().
+ *
+ * An arena is not thread-safe; fill it from a single thread.
+ */
+typedef struct _RecordArena RecordArena;
+
+/**
+ * Create a new arena. block_size of 0 selects the default block size.
+ */
+RecordArena* record_arena_new(gsize block_size);
+
+/**
+ * Free the arena and every record allocated from it
+ */
+void record_arena_free(RecordArena *arena);
+
+/**
+ * Release every record at once, keeping the blocks for reuse
+ */
+void record_arena_reset(RecordArena *arena);
+
+/**
+ * Allocate size bytes aligned for any record type
+ */
+gpointer record_arena_alloc(RecordArena *arena, gsize size);
+
+/**
+ * Copy a string into the arena
+ */
+char* record_arena_strdup(RecordArena *arena, const char *str);
+
+/**
+ * Arena statistics
+ */
+gsize record_arena_get_bytes_used(RecordArena *arena);
+guint record_arena_get_block_count(RecordArena *arena);
+
+#endif /* RECORD_ARENA_H */
@@ -0,0 +1,353 @@
+#include "student_map.h"
+#include <stdio.h>
+#include <string.h>
+
+#define STUDENT_MAP_MIN_CAPACITY 16
+/* Grow when size exceeds 7/8 of capacity - Robin Hood keeps probes short */
+#define STUDENT_MAP_LOAD_NUM 7
+#define STUDENT_MAP_LOAD_DEN 8
+#define STUDENT_MAP_POOL_CHUNK (64 * 1024)
+
+typedef struct {
+    guint64 hash;           /* cached full key hash */
+    const char *key;        /* interned in the pool; NULL marks an empty slot */
+    HashStudent *value;
+} StudentMapSlot;
+
+struct _StudentMap {
+    StudentMapSlot *slots;
+    gsize capacity;         /* always a power of two */
+    gsize mask;
+    guint size;
+
+    GStringChunk *pool;
+    gsize live_key_bytes;
+    gsize dead_key_bytes;   /* bytes of removed keys still held by the pool */
+
+    GDestroyNotify value_destroy;
+};
+
+/* =============================================================================
+ * wyhash (final version 4, public domain) - fast 64-bit string hash
+ * ============================================================================= */
+
+static const guint64 wy_secret[4] = {
+    0xa0761d6478bd642fULL, 0xe7037ed1a0b428dbULL,
+    0x8ebc6af09c88c6e3ULL, 0x589965cc75374cc3ULL
+};
+
+static inline void wy_mum(guint64 *a, guint64 *b) {
+#if defined(__SIZEOF_INT128__)
+    __extension__ typedef unsigned __int128 wy_u128;
+    wy_u128 r = (wy_u128)*a * *b;
+    *a = (guint64)r;
+    *b = (guint64)(r >> 64);
+#else
+    guint64 ha = *a >> 32, hb = *b >> 32, la = (guint32)*a, lb = (guint32)*b;
+    guint64 rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    guint64 t = rl + (rm0 << 32), lo, hi;
+    guint64 c = t < rl;
+    lo = t + (rm1 << 32);
+    c += lo < t;
+    hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+    *a = lo;
+    *b = hi;
+#endif
+}
+
+static inline guint64 wy_mix(guint64 a, guint64 b) {
+    wy_mum(&a, &b);
+    return a ^ b;
+}
+
+static inline guint64 wy_read8(const guint8 *p) {
+    guint64 v;
+    memcpy(&v, p, 8);
+    return v;
+}
+
+static inline guint64 wy_read4(const guint8 *p) {
+    guint32 v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+static inline guint64 wy_read3(const guint8 *p, gsize k) {
+    return ((guint64)p[0] << 16) | ((guint64)p[k >> 1] << 8) | p[k - 1];
+}
+
+guint64 student_map_hash_key(const char *key, gsize len) {
+    const guint8 *p = (const guint8*)key;
+    guint64 seed = wy_mix(wy_secret[0], wy_secret[1]);
+    guint64 a, b;
+
+    if (len <= 16) {
+        if (len >= 4) {
+            a = (wy_read4(p) << 32) | wy_read4(p + ((len >> 3) << 2));
+            b = (wy_read4(p + len - 4) << 32) | wy_read4(p + len - 4 - ((len >> 3) << 2));
+        } else if (len > 0) {
+            a = wy_read3(p, len);
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        gsize i = len;
+        if (i > 48) {
+            guint64 see1 = seed, see2 = seed;
+            do {
+                seed = wy_mix(wy_read8(p) ^ wy_secret[1], wy_read8(p + 8) ^ seed);
+                see1 = wy_mix(wy_read8(p + 16) ^ wy_secret[2], wy_read8(p + 24) ^ see1);
+                see2 = wy_mix(wy_read8(p + 32) ^ wy_secret[3], wy_read8(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= see1 ^ see2;
+        }
+        while (i > 16) {
+            seed = wy_mix(wy_read8(p) ^ wy_secret[1], wy_read8(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+        a = wy_read8(p + i - 16);
+        b = wy_read8(p + i - 8);
+    }
+
+    a ^= wy_secret[1];
+    b ^= seed;
+    wy_mum(&a, &b);
+    return wy_mix(a ^ wy_secret[0] ^ len, b ^ wy_secret[1]);
+}
+
+/* =============================================================================
+ * Robin Hood table
+ * ============================================================================= */
+
+static inline gsize probe_distance(StudentMap *map, gsize index, guint64 hash) {
+    return (index - (hash & map->mask)) & map->mask;
+}
+
+static gsize capacity_for(gsize n) {
+    gsize capacity = STUDENT_MAP_MIN_CAPACITY;
+    while (n * STUDENT_MAP_LOAD_DEN > capacity * STUDENT_MAP_LOAD_NUM) {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+StudentMap* student_map_new_full(guint reserved_size, GDestroyNotify value_destroy) {
+    StudentMap *map = g_malloc(sizeof(StudentMap));
+    map->capacity = capacity_for(reserved_size);
+    map->mask = map->capacity - 1;
+    map->slots = g_new0(StudentMapSlot, map->capacity);
+    map->size = 0;
+    map->pool = g_string_chunk_new(STUDENT_MAP_POOL_CHUNK);
+    map->live_key_bytes = 0;
+    map->dead_key_bytes = 0;
+    map->value_destroy = value_destroy;
+    return map;
+}
+
+StudentMap* student_map_new(guint reserved_size) {
+    return student_map_new_full(reserved_size, (GDestroyNotify)hash_student_free);
+}
+
+void student_map_free(StudentMap *map) {
+    if (map) {
+        if (map->value_destroy) {
+            for (gsize i = 0; i < map->capacity; i++) {
+                if (map->slots[i].key) {
+                    map->value_destroy(map->slots[i].value);
+                }
+            }
+        }
+        g_free(map->slots);
+        g_string_chunk_free(map->pool);
+        g_free(map);
+    }
+}
+
+// Place an entry known not to be present, displacing richer entries
+static void student_map_place(StudentMap *map, StudentMapSlot entry) {
+    gsize index = entry.hash & map->mask;
+    gsize distance = 0;
+
+    while (TRUE) {
+        StudentMapSlot *slot = &map->slots[index];
+        if (!slot->key) {
+            *slot = entry;
+            return;
+        }
+
+        gsize slot_distance = probe_distance(map, index, slot->hash);
+        if (slot_distance < distance) {
+            StudentMapSlot displaced = *slot;
+            *slot = entry;
+            entry = displaced;
+            distance = slot_distance;
+        }
+
+        index = (index + 1) & map->mask;
+        distance++;
+    }
+}
+
+// Rebuild the slot array; compacts the key pool when it is mostly dead
+static void student_map_rehash(StudentMap *map, gsize new_capacity) {
+    StudentMapSlot *old_slots = map->slots;
+    gsize old_capacity = map->capacity;
+    GStringChunk *old_pool = NULL;
+
+    if (map->dead_key_bytes > map->live_key_bytes) {
+        old_pool = map->pool;
+        map->pool = g_string_chunk_new(STUDENT_MAP_POOL_CHUNK);
+        map->dead_key_bytes = 0;
+    }
+
+    map->capacity = new_capacity;
+    map->mask = new_capacity - 1;
+    map->slots = g_new0(StudentMapSlot, new_capacity);
+
+    for (gsize i = 0; i < old_capacity; i++) {
+        if (old_slots[i].key) {
+            StudentMapSlot entry = old_slots[i];
+            if (old_pool) {
+                entry.key = g_string_chunk_insert(map->pool, entry.key);
+            }
+            student_map_place(map, entry);
+        }
+    }
+
+    g_free(old_slots);
+    if (old_pool) {
+        g_string_chunk_free(old_pool);
+    }
+}
+
+static StudentMapSlot* student_map_find(StudentMap *map, const char *key, guint64 hash) {
+    gsize index = hash & map->mask;
+    gsize distance = 0;
+
+    while (TRUE) {
+        StudentMapSlot *slot = &map->slots[index];
+        // An empty slot, or one richer than us, ends the probe sequence
+        if (!slot->key || probe_distance(map, index, slot->hash) < distance) {
+            return NULL;
+        }
+        if (slot->hash == hash && strcmp(slot->key, key) == 0) {
+            return slot;
+        }
+        index = (index + 1) & map->mask;
+        distance++;
+    }
+}
+
+void student_map_add_student(StudentMap *map, const char *key, HashStudent *student) {
+    g_return_if_fail(map != NULL && key != NULL);
+
+    gsize len = strlen(key);
+    guint64 hash = student_map_hash_key(key, len);
+
+    StudentMapSlot *existing = student_map_find(map, key, hash);
+    if (existing) {
+        if (map->value_destroy && existing->value != student) {
+            map->value_destroy(existing->value);
+        }
+        existing->value = student;
+        return;
+    }
+
+    if ((gsize)(map->size + 1) * STUDENT_MAP_LOAD_DEN > map->capacity * STUDENT_MAP_LOAD_NUM) {
+        student_map_rehash(map, map->capacity * 2);
+    }
+
+    StudentMapSlot entry = {
+        .hash = hash,
+        .key = g_string_chunk_insert_len(map->pool, key, (gssize)len),
+        .value = student
+    };
+    student_map_place(map, entry);
+    map->size++;
+    map->live_key_bytes += len + 1;
+}
+
+HashStudent* student_map_lookup(StudentMap *map, const char *key) {
+    g_return_val_if_fail(map != NULL && key != NULL, NULL);
+
+    StudentMapSlot *slot = student_map_find(map, key, student_map_hash_key(key, strlen(key)));
+    return slot ? slot->value : NULL;
+}
+
+gboolean student_map_contains(StudentMap *map, const char *key) {
+    g_return_val_if_fail(map != NULL && key != NULL, FALSE);
+    return student_map_find(map, key, student_map_hash_key(key, strlen(key))) != NULL;
+}
+
+gboolean student_map_remove(StudentMap *map, const char *key) {
+    g_return_val_if_fail(map != NULL && key != NULL, FALSE);
+
+    gsize len = strlen(key);
+    StudentMapSlot *slot = student_map_find(map, key, student_map_hash_key(key, len));
+    if (!slot) {
+        return FALSE;
+    }
+
+    if (map->value_destroy) {
+        map->value_destroy(slot->value);
+    }
+    map->size--;
+    map->live_key_bytes -= len + 1;
+    map->dead_key_bytes += len + 1;
+
+    // Backward-shift deletion: no tombstones, probe sequences stay short
+    gsize index = (gsize)(slot - map->slots);
+    gsize next = (index + 1) & map->mask;
+    while (map->slots[next].key && probe_distance(map, next, map->slots[next].hash) > 0) {
+        map->slots[index] = map->slots[next];
+        index = next;
+        next = (next + 1) & map->mask;
+    }
+    map->slots[index].key = NULL;
+    map->slots[index].value = NULL;
+
+    // Reclaim pool memory once removed keys dominate it
+    if (map->dead_key_bytes > STUDENT_MAP_POOL_CHUNK && map->dead_key_bytes > map->live_key_bytes) {
+        student_map_rehash(map, map->capacity);
+    }
+
+    return TRUE;
+}
+
+guint student_map_size(StudentMap *map) {
+    g_return_val_if_fail(map != NULL, 0);
+    return map->size;
+}
+
+void student_map_foreach(StudentMap *map, GHFunc func, gpointer user_data) {
+    g_return_if_fail(map != NULL && func != NULL);
+
+    for (gsize i = 0; i < map->capacity; i++) {
+        if (map->slots[i].key) {
+            func((gpointer)map->slots[i].key, map->slots[i].value, user_data);
+        }
+    }
+}
+
+// Helper function to print map contents
+static void print_map_entry(gpointer key, gpointer value, gpointer user_data) {
+    int *count = (int*)user_data;
+    printf("%d. Key: '%s' -> ", ++(*count), (const char*)key);
+    hash_student_print((HashStudent*)value);
+}
+
+void student_map_print_all(StudentMap *map) {
+    printf("\n--- Student Map Contents ---\n");
+    if (!map || map->size == 0) {
+        printf("  Student map is empty.\n");
+        return;
+    }
+
+    int count = 0;
+    student_map_foreach(map, print_map_entry, &count);
+    printf("Total entries: %u\n", map->size);
+}
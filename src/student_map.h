@@ -0,0 +1,53 @@
+#ifndef STUDENT_MAP_H
+#define STUDENT_MAP_H
+
+#include <glib.h>
+#include "test_hash_tables.h"
+
+/**
+ * Open-addressing string-keyed map specialized for student records.
+ *
+ * Compared with g_hash_table_new_full(g_str_hash, g_str_equal, g_free, ...):
+ * - Robin Hood linear probing over a flat slot array (no per-entry nodes)
+ * - each slot caches the full 64-bit key hash next to the key pointer
+ * - keys are interned into the map's string pool instead of one g_strdup
+ *   allocation per key; the pool is compacted when the map rehashes
+ * - keys are hashed with wyhash instead of djb2
+ *
+ * The surface mirrors the hash_table_* helpers in test_hash_tables.h.
+ */
+typedef struct _StudentMap StudentMap;
+
+/**
+ * Create a map that frees its students with hash_student_free()
+ */
+StudentMap* student_map_new(guint reserved_size);
+
+/**
+ * Create a map with a custom value destructor (NULL for none)
+ */
+StudentMap* student_map_new_full(guint reserved_size, GDestroyNotify value_destroy);
+void student_map_free(StudentMap *map);
+
+/**
+ * Insert or replace the student stored under key; the key is copied
+ */
+void student_map_add_student(StudentMap *map, const char *key, HashStudent *student);
+HashStudent* student_map_lookup(StudentMap *map, const char *key);
+gboolean student_map_contains(StudentMap *map, const char *key);
+gboolean student_map_remove(StudentMap *map, const char *key);
+guint student_map_size(StudentMap *map);
+
+/**
+ * Call func(key, student, user_data) for every entry; the map must not be
+ * modified from inside func
+ */
+void student_map_foreach(StudentMap *map, GHFunc func, gpointer user_data);
+void student_map_print_all(StudentMap *map);
+
+/**
+ * The map's key hash function (wyhash), exposed for benchmarking
+ */
+guint64 student_map_hash_key(const char *key, gsize len);
+
+#endif /* STUDENT_MAP_H */
@@ -0,0 +1,428 @@
+#include "student_table.h"
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define STUDENT_TABLE_HAVE_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+struct _StudentTable {
+    guint n_rows;
+    guint capacity;
+
+    /* Columns */
+    gint32 *student_id;
+    gdouble *gpa;
+    guint16 *major_code;
+    gchar **name;
+
+    /* Major dictionary: code -> string and string -> code + 1 */
+    GPtrArray *major_dict;
+    GHashTable *major_codes;
+};
+
+static gboolean simd_enabled = TRUE;
+
+StudentTable* student_table_new(guint reserved_rows) {
+    StudentTable *table = g_malloc0(sizeof(StudentTable));
+    table->capacity = MAX(reserved_rows, 64);
+    table->student_id = g_new(gint32, table->capacity);
+    table->gpa = g_new(gdouble, table->capacity);
+    table->major_code = g_new(guint16, table->capacity);
+    table->name = g_new(gchar*, table->capacity);
+    table->major_dict = g_ptr_array_new_with_free_func(g_free);
+    table->major_codes = g_hash_table_new(g_str_hash, g_str_equal);
+    return table;
+}
+
+void student_table_free(StudentTable *table) {
+    if (table) {
+        for (guint i = 0; i < table->n_rows; i++) {
+            g_free(table->name[i]);
+        }
+        g_free(table->student_id);
+        g_free(table->gpa);
+        g_free(table->major_code);
+        g_free(table->name);
+        // Keys of major_codes are owned by major_dict
+        g_hash_table_destroy(table->major_codes);
+        g_ptr_array_free(table->major_dict, TRUE);
+        g_free(table);
+    }
+}
+
+static void student_table_grow(StudentTable *table) {
+    table->capacity *= 2;
+    table->student_id = g_renew(gint32, table->student_id, table->capacity);
+    table->gpa = g_renew(gdouble, table->gpa, table->capacity);
+    table->major_code = g_renew(guint16, table->major_code, table->capacity);
+    table->name = g_renew(gchar*, table->name, table->capacity);
+}
+
+static guint16 student_table_intern_major(StudentTable *table, const char *major) {
+    gpointer code = g_hash_table_lookup(table->major_codes, major);
+    if (code) {
+        return (guint16)(GPOINTER_TO_UINT(code) - 1);
+    }
+
+    g_return_val_if_fail(table->major_dict->len <= G_MAXUINT16, 0);
+
+    guint16 new_code = (guint16)table->major_dict->len;
+    gchar *copy = g_strdup(major);
+    g_ptr_array_add(table->major_dict, copy);
+    g_hash_table_insert(table->major_codes, copy, GUINT_TO_POINTER((guint)new_code + 1));
+    return new_code;
+}
+
+guint student_table_append(StudentTable *table, const char *name, int student_id,
+                           double gpa, const char *major) {
+    g_return_val_if_fail(table != NULL, 0);
+
+    if (table->n_rows == table->capacity) {
+        student_table_grow(table);
+    }
+
+    guint row = table->n_rows++;
+    table->student_id[row] = student_id;
+    table->gpa[row] = gpa;
+    table->major_code[row] = student_table_intern_major(table, major ? major : "");
+    table->name[row] = g_strdup(name);
+    return row;
+}
+
+guint student_table_add_student(StudentTable *table, const HashStudent *student) {
+    g_return_val_if_fail(student != NULL, 0);
+    return student_table_append(table, student->name, student->student_id,
+                                student->gpa, student->major);
+}
+
+// Helper function to append every hash table value
+static void load_student_entry(gpointer key, gpointer value, gpointer user_data) {
+    (void)key;
+    student_table_add_student((StudentTable*)user_data, (HashStudent*)value);
+}
+
+void student_table_load_from_hash(StudentTable *table, GHashTable *students) {
+    g_return_if_fail(table != NULL);
+    g_hash_table_foreach(students, load_student_entry, table);
+}
+
+guint student_table_get_n_rows(StudentTable *table) {
+    g_return_val_if_fail(table != NULL, 0);
+    return table->n_rows;
+}
+
+const char* student_table_get_name(StudentTable *table, guint row) {
+    g_return_val_if_fail(table != NULL && row < table->n_rows, NULL);
+    return table->name[row];
+}
+
+int student_table_get_student_id(StudentTable *table, guint row) {
+    g_return_val_if_fail(table != NULL && row < table->n_rows, 0);
+    return table->student_id[row];
+}
+
+double student_table_get_gpa(StudentTable *table, guint row) {
+    g_return_val_if_fail(table != NULL && row < table->n_rows, 0.0);
+    return table->gpa[row];
+}
+
+const char* student_table_get_major(StudentTable *table, guint row) {
+    g_return_val_if_fail(table != NULL && row < table->n_rows, NULL);
+    return g_ptr_array_index(table->major_dict, table->major_code[row]);
+}
+
+void student_table_print_row(StudentTable *table, guint row) {
+    g_return_if_fail(table != NULL && row < table->n_rows);
+    printf("  ID: %d, Name: %s, GPA: %.2f, Major: %s\n",
+           table->student_id[row], table->name[row], table->gpa[row],
+           student_table_get_major(table, row));
+}
+
+gint student_table_lookup_major(StudentTable *table, const char *major) {
+    g_return_val_if_fail(table != NULL, -1);
+    g_return_val_if_fail(major != NULL, -1);
+    gpointer code = g_hash_table_lookup(table->major_codes, major);
+    return code ? (gint)GPOINTER_TO_UINT(code) - 1 : -1;
+}
+
+/* =============================================================================
+ * Selection Bitmaps
+ * ============================================================================= */
+
+static guint selection_words_for(guint n_rows) {
+    return (n_rows + 63) / 64;
+}
+
+StudentSelection* student_selection_new(StudentTable *table) {
+    g_return_val_if_fail(table != NULL, NULL);
+
+    StudentSelection *selection = g_malloc(sizeof(StudentSelection));
+    selection->n_rows = table->n_rows;
+    selection->n_words = selection_words_for(table->n_rows);
+    selection->words = g_new0(guint64, MAX(selection->n_words, 1));
+    return selection;
+}
+
+void student_selection_free(StudentSelection *selection) {
+    if (selection) {
+        g_free(selection->words);
+        g_free(selection);
+    }
+}
+
+// Size the bitmap for the current table, keeping it valid after appends
+static void selection_prepare(StudentSelection *selection, guint n_rows) {
+    guint n_words = selection_words_for(n_rows);
+    if (n_words > selection->n_words) {
+        selection->words = g_renew(guint64, selection->words, n_words);
+    }
+    selection->n_rows = n_rows;
+    selection->n_words = n_words;
+}
+
+void student_selection_and(StudentSelection *dest, const StudentSelection *other) {
+    g_return_if_fail(dest != NULL && other != NULL);
+    g_return_if_fail(dest->n_rows == other->n_rows);
+
+    for (guint i = 0; i < dest->n_words; i++) {
+        dest->words[i] &= other->words[i];
+    }
+}
+
+static guint popcount64(guint64 word) {
+#if defined(__GNUC__)
+    return (guint)__builtin_popcountll(word);
+#else
+    guint count = 0;
+    while (word) {
+        word &= word - 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
+static guint ctz64(guint64 word) {
+#if defined(__GNUC__)
+    return (guint)__builtin_ctzll(word);
+#else
+    guint index = 0;
+    while (!(word & 1)) {
+        word >>= 1;
+        index++;
+    }
+    return index;
+#endif
+}
+
+guint student_selection_count(const StudentSelection *selection) {
+    g_return_val_if_fail(selection != NULL, 0);
+
+    guint count = 0;
+    for (guint i = 0; i < selection->n_words; i++) {
+        count += popcount64(selection->words[i]);
+    }
+    return count;
+}
+
+gboolean student_selection_contains(const StudentSelection *selection, guint row) {
+    g_return_val_if_fail(selection != NULL, FALSE);
+    if (row >= selection->n_rows) {
+        return FALSE;
+    }
+    return (selection->words[row / 64] >> (row % 64)) & 1;
+}
+
+gint student_selection_next(const StudentSelection *selection, guint from) {
+    g_return_val_if_fail(selection != NULL, -1);
+    if (from >= selection->n_rows) {
+        return -1;
+    }
+
+    guint word_index = from / 64;
+    guint64 word = selection->words[word_index] & (~(guint64)0 << (from % 64));
+
+    while (TRUE) {
+        if (word) {
+            return (gint)(word_index * 64 + ctz64(word));
+        }
+        if (++word_index >= selection->n_words) {
+            return -1;
+        }
+        word = selection->words[word_index];
+    }
+}
+
+/* =============================================================================
+ * Filter Kernels
+ *
+ * Every kernel fills whole 64-row words; the trailing partial word is always
+ * handled by the scalar loop so the vector loops never read past n_rows.
+ * ============================================================================= */
+
+static guint64 gpa_word_scalar(const gdouble *gpa, guint count, gdouble min_gpa) {
+    guint64 bits = 0;
+    for (guint i = 0; i < count; i++) {
+        bits |= (guint64)(gpa[i] >= min_gpa) << i;
+    }
+    return bits;
+}
+
+static guint64 major_word_scalar(const guint16 *codes, guint count, guint16 code) {
+    guint64 bits = 0;
+    for (guint i = 0; i < count; i++) {
+        bits |= (guint64)(codes[i] == code) << i;
+    }
+    return bits;
+}
+
+#ifdef STUDENT_TABLE_HAVE_X86_SIMD
+
+__attribute__((target("sse2")))
+static guint64 gpa_word_sse2(const gdouble *gpa, gdouble min_gpa) {
+    __m128d threshold = _mm_set1_pd(min_gpa);
+    guint64 bits = 0;
+    for (guint i = 0; i < 64; i += 2) {
+        __m128d values = _mm_loadu_pd(gpa + i);
+        guint64 mask = (guint64)_mm_movemask_pd(_mm_cmpge_pd(values, threshold));
+        bits |= mask << i;
+    }
+    return bits;
+}
+
+__attribute__((target("avx2")))
+static guint64 gpa_word_avx2(const gdouble *gpa, gdouble min_gpa) {
+    __m256d threshold = _mm256_set1_pd(min_gpa);
+    guint64 bits = 0;
+    for (guint i = 0; i < 64; i += 4) {
+        __m256d values = _mm256_loadu_pd(gpa + i);
+        guint64 mask = (guint64)_mm256_movemask_pd(_mm256_cmp_pd(values, threshold, _CMP_GE_OQ));
+        bits |= mask << i;
+    }
+    return bits;
+}
+
+__attribute__((target("sse2")))
+static guint64 major_word_sse2(const guint16 *codes, guint16 code) {
+    __m128i needle = _mm_set1_epi16((short)code);
+    __m128i zero = _mm_setzero_si128();
+    guint64 bits = 0;
+    for (guint i = 0; i < 64; i += 8) {
+        __m128i values = _mm_loadu_si128((const __m128i*)(codes + i));
+        // Narrow the eight 16-bit lane masks to bytes before extracting
+        __m128i packed = _mm_packs_epi16(_mm_cmpeq_epi16(values, needle), zero);
+        bits |= (guint64)(_mm_movemask_epi8(packed) & 0xFF) << i;
+    }
+    return bits;
+}
+
+__attribute__((target("avx2")))
+static guint64 major_word_avx2(const guint16 *codes, guint16 code) {
+    __m256i needle = _mm256_set1_epi16((short)code);
+    guint64 bits = 0;
+    for (guint i = 0; i < 64; i += 32) {
+        __m256i lo = _mm256_cmpeq_epi16(_mm256_loadu_si256((const __m256i*)(codes + i)), needle);
+        __m256i hi = _mm256_cmpeq_epi16(_mm256_loadu_si256((const __m256i*)(codes + i + 16)), needle);
+        // packs works per 128-bit lane; restore row order before extracting
+        __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi16(lo, hi), 0xD8);
+        bits |= (guint64)(guint32)_mm256_movemask_epi8(packed) << i;
+    }
+    return bits;
+}
+
+#endif /* STUDENT_TABLE_HAVE_X86_SIMD */
+
+StudentTableSimd student_table_get_simd_level(void) {
+    if (!simd_enabled) {
+        return STUDENT_TABLE_SIMD_SCALAR;
+    }
+#ifdef STUDENT_TABLE_HAVE_X86_SIMD
+    static gsize detected = 0;
+    static StudentTableSimd level = STUDENT_TABLE_SIMD_SCALAR;
+
+    if (g_once_init_enter(&detected)) {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            level = STUDENT_TABLE_SIMD_AVX2;
+        } else if (__builtin_cpu_supports("sse2")) {
+            level = STUDENT_TABLE_SIMD_SSE2;
+        }
+        g_once_init_leave(&detected, 1);
+    }
+    return level;
+#else
+    return STUDENT_TABLE_SIMD_SCALAR;
+#endif
+}
+
+void student_table_set_simd_enabled(gboolean enabled) {
+    simd_enabled = enabled;
+}
+
+void student_table_filter_gpa_at_least(StudentTable *table, double min_gpa, StudentSelection *out) {
+    g_return_if_fail(table != NULL && out != NULL);
+
+    selection_prepare(out, table->n_rows);
+    StudentTableSimd level = student_table_get_simd_level();
+    guint full_words = table->n_rows / 64;
+
+    for (guint w = 0; w < full_words; w++) {
+        const gdouble *gpa = table->gpa + (gsize)w * 64;
+        switch (level) {
+#ifdef STUDENT_TABLE_HAVE_X86_SIMD
+            case STUDENT_TABLE_SIMD_AVX2:
+                out->words[w] = gpa_word_avx2(gpa, min_gpa);
+                break;
+            case STUDENT_TABLE_SIMD_SSE2:
+                out->words[w] = gpa_word_sse2(gpa, min_gpa);
+                break;
+#endif
+            default:
+                out->words[w] = gpa_word_scalar(gpa, 64, min_gpa);
+                break;
+        }
+    }
+
+    if (table->n_rows % 64) {
+        out->words[full_words] = gpa_word_scalar(table->gpa + (gsize)full_words * 64,
+                                                 table->n_rows % 64, min_gpa);
+    }
+}
+
+void student_table_filter_major(StudentTable *table, const char *major, StudentSelection *out) {
+    g_return_if_fail(table != NULL && major != NULL && out != NULL);
+
+    selection_prepare(out, table->n_rows);
+    gint code = student_table_lookup_major(table, major);
+    if (code < 0) {
+        memset(out->words, 0, out->n_words * sizeof(guint64));
+        return;
+    }
+
+    StudentTableSimd level = student_table_get_simd_level();
+    guint full_words = table->n_rows / 64;
+
+    for (guint w = 0; w < full_words; w++) {
+        const guint16 *codes = table->major_code + (gsize)w * 64;
+        switch (level) {
+#ifdef STUDENT_TABLE_HAVE_X86_SIMD
+            case STUDENT_TABLE_SIMD_AVX2:
+                out->words[w] = major_word_avx2(codes, (guint16)code);
+                break;
+            case STUDENT_TABLE_SIMD_SSE2:
+                out->words[w] = major_word_sse2(codes, (guint16)code);
+                break;
+#endif
+            default:
+                out->words[w] = major_word_scalar(codes, 64, (guint16)code);
+                break;
+        }
+    }
+
+    if (table->n_rows % 64) {
+        out->words[full_words] = major_word_scalar(table->major_code + (gsize)full_words * 64,
+                                                   table->n_rows % 64, (guint16)code);
+    }
+}
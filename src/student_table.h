@@ -0,0 +1,99 @@
+#ifndef STUDENT_TABLE_H
+#define STUDENT_TABLE_H
+
+#include <glib.h>
+#include "test_hash_tables.h"
+
+/**
+ * Columnar (struct-of-arrays) student store for analytic scans.
+ *
+ * Each HashStudent field lives in its own contiguous column:
+ * - gpa        -> gdouble[]
+ * - student_id -> gint32[]
+ * - major      -> guint16[] dictionary codes (one string per distinct major)
+ * - name       -> gchar*[]
+ *
+ * Filters scan a single column with SSE2/AVX2 when available (scalar
+ * otherwise) and write a StudentSelection bitmap with one bit per row.
+ */
+typedef struct _StudentTable StudentTable;
+
+/**
+ * Selection bitmap produced by the filters: bit (row % 64) of
+ * words[row / 64] is set when the row matches
+ */
+typedef struct {
+    guint64 *words;
+    guint n_rows;
+    guint n_words;
+} StudentSelection;
+
+/**
+ * SIMD level used by the filter kernels
+ */
+typedef enum {
+    STUDENT_TABLE_SIMD_SCALAR,
+    STUDENT_TABLE_SIMD_SSE2,
+    STUDENT_TABLE_SIMD_AVX2
+} StudentTableSimd;
+
+/**
+ * Create and free a table
+ */
+StudentTable* student_table_new(guint reserved_rows);
+void student_table_free(StudentTable *table);
+
+/**
+ * Append a row; returns its row index
+ */
+guint student_table_append(StudentTable *table, const char *name, int student_id,
+                           double gpa, const char *major);
+guint student_table_add_student(StudentTable *table, const HashStudent *student);
+
+/**
+ * Append every HashStudent stored as a value of a student hash table
+ */
+void student_table_load_from_hash(StudentTable *table, GHashTable *students);
+
+/**
+ * Row and column accessors
+ */
+guint student_table_get_n_rows(StudentTable *table);
+const char* student_table_get_name(StudentTable *table, guint row);
+int student_table_get_student_id(StudentTable *table, guint row);
+double student_table_get_gpa(StudentTable *table, guint row);
+const char* student_table_get_major(StudentTable *table, guint row);
+void student_table_print_row(StudentTable *table, guint row);
+
+/**
+ * Dictionary code of a major, or -1 when no row uses it
+ */
+gint student_table_lookup_major(StudentTable *table, const char *major);
+
+/**
+ * Vectorized filters; out must have been created for this table
+ */
+void student_table_filter_gpa_at_least(StudentTable *table, double min_gpa, StudentSelection *out);
+void student_table_filter_major(StudentTable *table, const char *major, StudentSelection *out);
+
+/**
+ * SIMD dispatch control (mainly for benchmarking the scalar fallback)
+ */
+StudentTableSimd student_table_get_simd_level(void);
+void student_table_set_simd_enabled(gboolean enabled);
+
+/**
+ * Selection bitmap operations
+ */
+StudentSelection* student_selection_new(StudentTable *table);
+void student_selection_free(StudentSelection *selection);
+void student_selection_and(StudentSelection *dest, const StudentSelection *other);
+guint student_selection_count(const StudentSelection *selection);
+gboolean student_selection_contains(const StudentSelection *selection, guint row);
+
+/**
+ * Return the first selected row >= from, or -1 when there is none
+ */
+gint student_selection_next(const StudentSelection *selection, guint from);
+
+#endif /* STUDENT_TABLE_H */
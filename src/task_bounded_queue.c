@@ -0,0 +1,334 @@
+#include "task_bounded_queue.h"
+#include <stdio.h>
+#include <string.h>
+
+struct _TaskBoundedQueue {
+    GMutex lock;
+    GCond not_empty;
+    GCond not_full;
+    QueueTask **tasks;
+    guint capacity;
+    guint head;                 /* index of the oldest task */
+    guint length;
+    guint waiting_producers;    /* only signal a condition someone waits on */
+    guint waiting_consumers;
+
+    guint high_watermark;
+    guint low_watermark;
+    gboolean above_high;        /* high reached, low not yet */
+    TaskWatermarkFunc on_high;
+    TaskWatermarkFunc on_low;
+    gpointer watermark_data;
+
+    TaskBoundedQueueStats stats;
+};
+
+// Clamp a relative timeout to something g_get_monotonic_time() can add safely
+static inline gint64 bounded_queue_end_time(guint64 timeout_us) {
+    return g_get_monotonic_time() + (gint64)MIN(timeout_us, (guint64)G_MAXINT32 * G_USEC_PER_SEC);
+}
+
+/* =============================================================================
+ * Locked Operations
+ * ============================================================================= */
+
+// Append to a locked queue that has room
+static void task_bounded_queue_push_locked(TaskBoundedQueue *queue, QueueTask *task) {
+    guint tail = queue->head + queue->length;
+    if (tail >= queue->capacity) {
+        tail -= queue->capacity;
+    }
+    queue->tasks[tail] = task;
+    queue->length++;
+
+    queue->stats.pushed++;
+    queue->stats.depth_sum += queue->length;
+    queue->stats.max_depth = MAX(queue->stats.max_depth, queue->length);
+
+    if (!queue->above_high && queue->length >= queue->high_watermark) {
+        queue->above_high = TRUE;
+        queue->stats.high_events++;
+        if (queue->on_high) {
+            queue->on_high(queue, queue->length, queue->watermark_data);
+        }
+    }
+
+    if (queue->waiting_consumers > 0) {
+        g_cond_signal(&queue->not_empty);
+    }
+}
+
+// Take the oldest task of a locked, non-empty queue
+static QueueTask* task_bounded_queue_pop_locked(TaskBoundedQueue *queue) {
+    QueueTask *task = queue->tasks[queue->head];
+    queue->head++;
+    if (queue->head == queue->capacity) {
+        queue->head = 0;
+    }
+    queue->length--;
+    queue->stats.popped++;
+
+    if (queue->above_high && queue->length <= queue->low_watermark) {
+        queue->above_high = FALSE;
+        queue->stats.low_events++;
+        if (queue->on_low) {
+            queue->on_low(queue, queue->length, queue->watermark_data);
+        }
+    }
+
+    if (queue->waiting_producers > 0) {
+        g_cond_signal(&queue->not_full);
+    }
+    return task;
+}
+
+// Wait for space until end_time (-1 = forever); the queue must be locked
+static gboolean task_bounded_queue_wait_space(TaskBoundedQueue *queue, gint64 end_time) {
+    if (queue->length < queue->capacity) {
+        return TRUE;
+    }
+
+    gint64 start = g_get_monotonic_time();
+    queue->waiting_producers++;
+    while (queue->length == queue->capacity) {
+        if (end_time < 0) {
+            g_cond_wait(&queue->not_full, &queue->lock);
+        } else if (!g_cond_wait_until(&queue->not_full, &queue->lock, end_time)) {
+            break;
+        }
+    }
+    queue->waiting_producers--;
+    task_delay_histogram_record(&queue->stats.push_wait,
+                                (guint64)MAX(g_get_monotonic_time() - start, 0));
+
+    return queue->length < queue->capacity;
+}
+
+// Wait for a task until end_time (-1 = forever); the queue must be locked
+static gboolean task_bounded_queue_wait_task(TaskBoundedQueue *queue, gint64 end_time) {
+    if (queue->length > 0) {
+        return TRUE;
+    }
+
+    gint64 start = g_get_monotonic_time();
+    queue->waiting_consumers++;
+    while (queue->length == 0) {
+        if (end_time < 0) {
+            g_cond_wait(&queue->not_empty, &queue->lock);
+        } else if (!g_cond_wait_until(&queue->not_empty, &queue->lock, end_time)) {
+            break;
+        }
+    }
+    queue->waiting_consumers--;
+    task_delay_histogram_record(&queue->stats.pop_wait,
+                                (guint64)MAX(g_get_monotonic_time() - start, 0));
+
+    return queue->length > 0;
+}
+
+/* =============================================================================
+ * Queue
+ * ============================================================================= */
+
+TaskBoundedQueue* task_bounded_queue_new(guint capacity) {
+    g_return_val_if_fail(capacity > 0, NULL);
+
+    TaskBoundedQueue *queue = g_new0(TaskBoundedQueue, 1);
+    g_mutex_init(&queue->lock);
+    g_cond_init(&queue->not_empty);
+    g_cond_init(&queue->not_full);
+    queue->tasks = g_new(QueueTask*, capacity);
+    queue->capacity = capacity;
+    queue->high_watermark = capacity;
+    queue->low_watermark = capacity / 2;
+    return queue;
+}
+
+void task_bounded_queue_free(TaskBoundedQueue *queue) {
+    if (queue) {
+        g_free(queue->tasks);
+        g_cond_clear(&queue->not_full);
+        g_cond_clear(&queue->not_empty);
+        g_mutex_clear(&queue->lock);
+        g_free(queue);
+    }
+}
+
+void task_bounded_queue_set_watermarks(TaskBoundedQueue *queue, guint high, guint low,
+                                       TaskWatermarkFunc on_high, TaskWatermarkFunc on_low,
+                                       gpointer user_data) {
+    g_return_if_fail(queue != NULL);
+    g_return_if_fail(low < high && high <= queue->capacity);
+
+    g_mutex_lock(&queue->lock);
+    queue->high_watermark = high;
+    queue->low_watermark = low;
+    queue->above_high = queue->length >= high;
+    queue->on_high = on_high;
+    queue->on_low = on_low;
+    queue->watermark_data = user_data;
+    g_mutex_unlock(&queue->lock);
+}
+
+void task_bounded_queue_push(TaskBoundedQueue *queue, QueueTask *task) {
+    g_return_if_fail(queue != NULL && task != NULL);
+
+    g_mutex_lock(&queue->lock);
+    task_bounded_queue_wait_space(queue, -1);
+    task_bounded_queue_push_locked(queue, task);
+    g_mutex_unlock(&queue->lock);
+}
+
+gboolean task_bounded_queue_try_push(TaskBoundedQueue *queue, QueueTask *task) {
+    g_return_val_if_fail(queue != NULL && task != NULL, FALSE);
+
+    gboolean pushed = FALSE;
+    g_mutex_lock(&queue->lock);
+    if (queue->length < queue->capacity) {
+        task_bounded_queue_push_locked(queue, task);
+        pushed = TRUE;
+    } else {
+        queue->stats.rejected++;
+    }
+    g_mutex_unlock(&queue->lock);
+    return pushed;
+}
+
+gboolean task_bounded_queue_timeout_push(TaskBoundedQueue *queue, QueueTask *task, guint64 timeout_us) {
+    g_return_val_if_fail(queue != NULL && task != NULL, FALSE);
+
+    gint64 end_time = bounded_queue_end_time(timeout_us);
+    gboolean pushed = FALSE;
+
+    g_mutex_lock(&queue->lock);
+    if (task_bounded_queue_wait_space(queue, end_time)) {
+        task_bounded_queue_push_locked(queue, task);
+        pushed = TRUE;
+    } else {
+        queue->stats.rejected++;
+    }
+    g_mutex_unlock(&queue->lock);
+    return pushed;
+}
+
+QueueTask* task_bounded_queue_pop(TaskBoundedQueue *queue) {
+    g_return_val_if_fail(queue != NULL, NULL);
+
+    g_mutex_lock(&queue->lock);
+    task_bounded_queue_wait_task(queue, -1);
+    QueueTask *task = task_bounded_queue_pop_locked(queue);
+    g_mutex_unlock(&queue->lock);
+    return task;
+}
+
+QueueTask* task_bounded_queue_try_pop(TaskBoundedQueue *queue) {
+    g_return_val_if_fail(queue != NULL, NULL);
+
+    QueueTask *task = NULL;
+    g_mutex_lock(&queue->lock);
+    if (queue->length > 0) {
+        task = task_bounded_queue_pop_locked(queue);
+    }
+    g_mutex_unlock(&queue->lock);
+    return task;
+}
+
+QueueTask* task_bounded_queue_timeout_pop(TaskBoundedQueue *queue, guint64 timeout_us) {
+    g_return_val_if_fail(queue != NULL, NULL);
+
+    gint64 end_time = bounded_queue_end_time(timeout_us);
+    QueueTask *task = NULL;
+
+    g_mutex_lock(&queue->lock);
+    if (task_bounded_queue_wait_task(queue, end_time)) {
+        task = task_bounded_queue_pop_locked(queue);
+    }
+    g_mutex_unlock(&queue->lock);
+    return task;
+}
+
+guint task_bounded_queue_length(TaskBoundedQueue *queue) {
+    g_return_val_if_fail(queue != NULL, 0);
+
+    g_mutex_lock(&queue->lock);
+    guint length = queue->length;
+    g_mutex_unlock(&queue->lock);
+    return length;
+}
+
+guint task_bounded_queue_get_capacity(TaskBoundedQueue *queue) {
+    g_return_val_if_fail(queue != NULL, 0);
+    return queue->capacity;
+}
+
+/* =============================================================================
+ * Statistics
+ * ============================================================================= */
+
+void task_bounded_queue_get_stats(TaskBoundedQueue *queue, TaskBoundedQueueStats *out) {
+    g_return_if_fail(queue != NULL && out != NULL);
+
+    g_mutex_lock(&queue->lock);
+    *out = queue->stats;
+    g_mutex_unlock(&queue->lock);
+}
+
+void task_bounded_queue_reset_stats(TaskBoundedQueue *queue) {
+    g_return_if_fail(queue != NULL);
+
+    g_mutex_lock(&queue->lock);
+    memset(&queue->stats, 0, sizeof(TaskBoundedQueueStats));
+    g_mutex_unlock(&queue->lock);
+}
+
+static void print_wait_row(const char *label, const TaskDelayHistogram *wait) {
+    printf("%-9s %10" G_GUINT64_FORMAT " %10" G_GUINT64_FORMAT " %10" G_GUINT64_FORMAT
+           " %10" G_GUINT64_FORMAT " %10" G_GUINT64_FORMAT "\n",
+           label, wait->count,
+           wait->count ? wait->total_us / wait->count : 0,
+           task_delay_histogram_percentile(wait, 0.50),
+           task_delay_histogram_percentile(wait, 0.99),
+           wait->max_us);
+}
+
+void task_bounded_queue_print_stats(TaskBoundedQueue *queue) {
+    g_return_if_fail(queue != NULL);
+
+    TaskBoundedQueueStats stats;
+    task_bounded_queue_get_stats(queue, &stats);
+
+    printf("\n--- Task Bounded Queue (capacity %u) ---\n", queue->capacity);
+    printf("Pushed: %" G_GUINT64_FORMAT ", popped: %" G_GUINT64_FORMAT
+           ", rejected: %" G_GUINT64_FORMAT "\n",
+           stats.pushed, stats.popped, stats.rejected);
+    printf("Depth: mean %.1f, max %u\n",
+           stats.pushed ? (double)stats.depth_sum / (double)stats.pushed : 0.0, stats.max_depth);
+    printf("Watermarks: high reached %" G_GUINT64_FORMAT "x, drained to low %" G_GUINT64_FORMAT "x\n",
+           stats.high_events, stats.low_events);
+    printf("%-9s %10s %10s %10s %10s %10s\n",
+           "waits", "count", "mean (us)", "p50 (us)", "p99 (us)", "max (us)");
+    print_wait_row("producer", &stats.push_wait);
+    print_wait_row("consumer", &stats.pop_wait);
+}
+
+/* =============================================================================
+ * Producer/Consumer Transport
+ * ============================================================================= */
+
+static void task_bounded_queue_transport_push(gpointer queue, QueueTask *task) {
+    task_bounded_queue_push((TaskBoundedQueue*)queue, task);
+}
+
+static QueueTask* task_bounded_queue_transport_pop(gpointer queue) {
+    return task_bounded_queue_pop((TaskBoundedQueue*)queue);
+}
+
+static QueueTask* task_bounded_queue_transport_timeout_pop(gpointer queue, guint64 timeout_us) {
+    return task_bounded_queue_timeout_pop((TaskBoundedQueue*)queue, timeout_us);
+}
+
+const TaskTransport task_bounded_queue_transport = {
+    .push = task_bounded_queue_transport_push,
+    .pop = task_bounded_queue_transport_pop,
+    .timeout_pop = task_bounded_queue_transport_timeout_pop
+};
@@ -0,0 +1,99 @@
+#ifndef TASK_BOUNDED_QUEUE_H
+#define TASK_BOUNDED_QUEUE_H
+
+#include <glib.h>
+#include "test_async_queue.h"
+
+/**
+ * Fixed-capacity, thread-safe QueueTask FIFO with back-pressure.
+ *
+ * Unlike GAsyncQueue, a full queue makes producers wait (push), give up
+ * after a timeout (timeout_push) or fail immediately (try_push), so memory
+ * stays bounded when consumers stall.
+ *
+ * Watermarks add hysteresis on top: the high callback runs once when the
+ * depth reaches the high watermark, and the low callback runs once the depth
+ * has drained back down to the low watermark. Both run on the pushing or
+ * popping thread with the queue locked, so they are delivered in order but
+ * must not call back into the queue.
+ */
+typedef struct _TaskBoundedQueue TaskBoundedQueue;
+
+typedef void (*TaskWatermarkFunc)(TaskBoundedQueue *queue, guint depth, gpointer user_data);
+
+/**
+ * Queue depth and wait-time metrics
+ */
+typedef struct {
+    guint64 pushed;
+    guint64 popped;
+    guint64 rejected;               /* try/timeout pushes that found the queue full */
+    guint64 high_events;            /* high watermark reached */
+    guint64 low_events;             /* drained back to the low watermark */
+    guint max_depth;
+    guint64 depth_sum;              /* depth after every push; mean = depth_sum / pushed */
+    TaskDelayHistogram push_wait;   /* pushes that had to wait for space */
+    TaskDelayHistogram pop_wait;    /* pops that had to wait for a task */
+} TaskBoundedQueueStats;
+
+/**
+ * Create a queue holding at most capacity tasks. The watermarks default to
+ * capacity (high) and capacity / 2 (low), without callbacks.
+ */
+TaskBoundedQueue* task_bounded_queue_new(guint capacity);
+
+/**
+ * Free the queue. Tasks still queued are not freed.
+ */
+void task_bounded_queue_free(TaskBoundedQueue *queue);
+
+/**
+ * Set the watermarks (low < high <= capacity) and their callbacks (either may be NULL)
+ */
+void task_bounded_queue_set_watermarks(TaskBoundedQueue *queue, guint high, guint low,
+                                       TaskWatermarkFunc on_high, TaskWatermarkFunc on_low,
+                                       gpointer user_data);
+
+/**
+ * Block while the queue is full
+ */
+void task_bounded_queue_push(TaskBoundedQueue *queue, QueueTask *task);
+
+/**
+ * Push without waiting; FALSE (task not queued) if the queue is full
+ */
+gboolean task_bounded_queue_try_push(TaskBoundedQueue *queue, QueueTask *task);
+
+/**
+ * Wait up to timeout_us for space; FALSE (task not queued) on timeout
+ */
+gboolean task_bounded_queue_timeout_push(TaskBoundedQueue *queue, QueueTask *task, guint64 timeout_us);
+
+/**
+ * Pop operations, mirroring g_async_queue_pop/try_pop/timeout_pop
+ */
+QueueTask* task_bounded_queue_pop(TaskBoundedQueue *queue);
+QueueTask* task_bounded_queue_try_pop(TaskBoundedQueue *queue);
+QueueTask* task_bounded_queue_timeout_pop(TaskBoundedQueue *queue, guint64 timeout_us);
+
+guint task_bounded_queue_length(TaskBoundedQueue *queue);
+guint task_bounded_queue_get_capacity(TaskBoundedQueue *queue);
+
+/**
+ * Copy or clear the metrics
+ */
+void task_bounded_queue_get_stats(TaskBoundedQueue *queue, TaskBoundedQueueStats *out);
+void task_bounded_queue_reset_stats(TaskBoundedQueue *queue);
+
+/**
+ * Print depth, rejections, watermark events and producer/consumer wait times
+ */
+void task_bounded_queue_print_stats(TaskBoundedQueue *queue);
+
+/**
+ * TaskBoundedQueue transport for producer_function/consumer_function
+ * (push blocks while the queue is full)
+ */
+extern const TaskTransport task_bounded_queue_transport;
+
+#endif /* TASK_BOUNDED_QUEUE_H */
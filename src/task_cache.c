@@ -0,0 +1,233 @@
+#include "task_cache.h"
+#include <stdatomic.h>
+
+/* Magazines kept by the depot; further ones are returned to the system */
+#define TASK_DEPOT_MAX_MAGAZINES 64
+
+typedef struct _TaskCacheNode TaskCacheNode;
+
+/**
+ * Overlay on the memory of a free task
+ */
+struct _TaskCacheNode {
+    TaskCacheNode *next;            /* next free task in the same magazine */
+    TaskCacheNode *next_magazine;   /* depot chain; valid on a magazine's first task */
+    gsize magazine_count;           /* valid on a magazine's first task in the depot */
+};
+
+G_STATIC_ASSERT(sizeof(TaskCacheNode) <= sizeof(QueueTask));
+
+typedef struct {
+    TaskCacheNode *head;
+    guint count;
+} TaskMagazine;
+
+/**
+ * Per-thread cache: tasks come from and go back to loaded; spare is either
+ * empty or a full magazine, so a thread alternating between allocating and
+ * freeing around a magazine boundary does not bounce magazines off the depot
+ */
+typedef struct {
+    TaskMagazine loaded;
+    TaskMagazine spare;
+} TaskThreadCache;
+
+static struct {
+    GMutex lock;                    /* statically allocated: no init needed */
+    TaskCacheNode *magazines;
+    guint n_magazines;
+} depot;
+
+static atomic_uint_fast64_t stat_allocated;
+static atomic_uint_fast64_t stat_released;
+static atomic_uint_fast64_t stat_depot_puts;
+static atomic_uint_fast64_t stat_depot_gets;
+
+static void task_thread_cache_destroy(gpointer data);
+
+static GPrivate thread_cache = G_PRIVATE_INIT(task_thread_cache_destroy);
+
+/* =============================================================================
+ * Depot
+ * ============================================================================= */
+
+static void magazine_release(TaskMagazine *magazine) {
+    TaskCacheNode *node = magazine->head;
+    while (node) {
+        TaskCacheNode *next = node->next;
+        g_free(node);
+        node = next;
+    }
+    atomic_fetch_add_explicit(&stat_released, magazine->count, memory_order_relaxed);
+    magazine->head = NULL;
+    magazine->count = 0;
+}
+
+// Hand a non-empty magazine to the depot; leaves magazine empty
+static void depot_put(TaskMagazine *magazine) {
+    gboolean stored = FALSE;
+
+    g_mutex_lock(&depot.lock);
+    if (depot.n_magazines < TASK_DEPOT_MAX_MAGAZINES) {
+        magazine->head->magazine_count = magazine->count;
+        magazine->head->next_magazine = depot.magazines;
+        depot.magazines = magazine->head;
+        depot.n_magazines++;
+        stored = TRUE;
+    }
+    g_mutex_unlock(&depot.lock);
+
+    if (stored) {
+        atomic_fetch_add_explicit(&stat_depot_puts, 1, memory_order_relaxed);
+        magazine->head = NULL;
+        magazine->count = 0;
+    } else {
+        magazine_release(magazine);
+    }
+}
+
+// Fill an empty magazine from the depot; FALSE if the depot is empty
+static gboolean depot_get(TaskMagazine *magazine) {
+    g_mutex_lock(&depot.lock);
+    TaskCacheNode *head = depot.magazines;
+    if (head) {
+        depot.magazines = head->next_magazine;
+        depot.n_magazines--;
+    }
+    g_mutex_unlock(&depot.lock);
+
+    if (!head) {
+        return FALSE;
+    }
+    atomic_fetch_add_explicit(&stat_depot_gets, 1, memory_order_relaxed);
+    magazine->head = head;
+    magazine->count = (guint)head->magazine_count;
+    return TRUE;
+}
+
+/* =============================================================================
+ * Thread Cache
+ * ============================================================================= */
+
+static TaskThreadCache* get_thread_cache(void) {
+    TaskThreadCache *cache = g_private_get(&thread_cache);
+    if (G_UNLIKELY(!cache)) {
+        cache = g_new0(TaskThreadCache, 1);
+        g_private_set(&thread_cache, cache);
+    }
+    return cache;
+}
+
+static void task_thread_cache_flush(TaskThreadCache *cache) {
+    if (cache->loaded.count > 0) {
+        depot_put(&cache->loaded);
+    }
+    if (cache->spare.count > 0) {
+        depot_put(&cache->spare);
+    }
+}
+
+// Runs when a thread exits: its tasks become available to other threads
+static void task_thread_cache_destroy(gpointer data) {
+    TaskThreadCache *cache = (TaskThreadCache*)data;
+    task_thread_cache_flush(cache);
+    g_free(cache);
+}
+
+static QueueTask* task_cache_alloc(void) {
+    TaskThreadCache *cache = get_thread_cache();
+
+    if (cache->loaded.count == 0) {
+        if (cache->spare.count > 0) {
+            TaskMagazine empty = cache->loaded;
+            cache->loaded = cache->spare;
+            cache->spare = empty;
+        } else if (!depot_get(&cache->loaded)) {
+            atomic_fetch_add_explicit(&stat_allocated, 1, memory_order_relaxed);
+            return g_malloc(sizeof(QueueTask));
+        }
+    }
+
+    TaskCacheNode *node = cache->loaded.head;
+    cache->loaded.head = node->next;
+    cache->loaded.count--;
+    return (QueueTask*)node;
+}
+
+static void task_cache_put(QueueTask *task) {
+    TaskThreadCache *cache = get_thread_cache();
+
+    if (cache->loaded.count == TASK_CACHE_MAGAZINE_SIZE) {
+        // Keep one full magazine locally; older full ones go to the depot
+        if (cache->spare.count > 0) {
+            depot_put(&cache->spare);
+        }
+        cache->spare = cache->loaded;
+        cache->loaded.head = NULL;
+        cache->loaded.count = 0;
+    }
+
+    TaskCacheNode *node = (TaskCacheNode*)task;
+    node->next = cache->loaded.head;
+    cache->loaded.head = node;
+    cache->loaded.count++;
+}
+
+/* =============================================================================
+ * Public API
+ * ============================================================================= */
+
+QueueTask* queue_task_new_cached(int task_id, const char *ref_description, int priority) {
+    g_return_val_if_fail(ref_description != NULL, NULL);
+
+    QueueTask *task = task_cache_alloc();
+    task->task_id = task_id;
+    task->description = g_ref_string_acquire((char*)ref_description);
+    task->priority = priority;
+    task->completed = FALSE;
+    task->enqueued_us = 0;
+    task->payload = NULL;
+    return task;
+}
+
+void queue_task_free_cached(QueueTask *task) {
+    if (task) {
+        g_ref_string_release(task->description);
+        if (task->payload) {
+            g_bytes_unref(task->payload);
+        }
+        task_cache_put(task);
+    }
+}
+
+void queue_task_cache_flush(void) {
+    TaskThreadCache *cache = g_private_get(&thread_cache);
+    if (cache) {
+        task_thread_cache_flush(cache);
+    }
+}
+
+void queue_task_cache_trim(void) {
+    queue_task_cache_flush();
+
+    g_mutex_lock(&depot.lock);
+    TaskCacheNode *magazines = depot.magazines;
+    depot.magazines = NULL;
+    depot.n_magazines = 0;
+    g_mutex_unlock(&depot.lock);
+
+    while (magazines) {
+        TaskMagazine magazine = { magazines, (guint)magazines->magazine_count };
+        magazines = magazines->next_magazine;
+        magazine_release(&magazine);
+    }
+}
+
+void queue_task_cache_get_stats(QueueTaskCacheStats *stats) {
+    g_return_if_fail(stats != NULL);
+
+    stats->allocated = atomic_load_explicit(&stat_allocated, memory_order_relaxed);
+    stats->released = atomic_load_explicit(&stat_released, memory_order_relaxed);
+    stats->depot_puts = atomic_load_explicit(&stat_depot_puts, memory_order_relaxed);
+    stats->depot_gets = atomic_load_explicit(&stat_depot_gets, memory_order_relaxed);
+}
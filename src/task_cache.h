@@ -0,0 +1,57 @@
+#ifndef TASK_CACHE_H
+#define TASK_CACHE_H
+
+#include <glib.h>
+#include "test_async_queue.h"
+
+/**
+ * Thread-caching allocator for QueueTask structs.
+ *
+ * Freed tasks go to a small per-thread cache instead of g_free(). When a
+ * thread's cache overflows (typically a consumer), a full magazine of tasks
+ * moves to a shared depot; when a thread's cache runs dry (typically a
+ * producer), it takes a magazine from the depot before falling back to
+ * g_malloc(). Only whole magazines cross threads, so the depot lock is
+ * taken once per TASK_CACHE_MAGAZINE_SIZE tasks.
+ *
+ * Cached tasks are ordinary g_malloc() blocks: queue_task_free() may free
+ * a cached task and queue_task_free_cached() may recycle any task made by
+ * queue_task_new*(). Arena tasks must not be passed to either.
+ */
+#define TASK_CACHE_MAGAZINE_SIZE 64
+
+/**
+ * Allocator counters (totals across all threads)
+ */
+typedef struct {
+    guint64 allocated;      /* tasks obtained from g_malloc() */
+    guint64 released;       /* tasks given back with g_free() */
+    guint64 depot_puts;     /* magazines moved into the depot */
+    guint64 depot_gets;     /* magazines taken from the depot */
+} QueueTaskCacheStats;
+
+/**
+ * Create a task from the calling thread's cache. ref_description is a
+ * GRefString, shared as in queue_task_new_shared().
+ */
+QueueTask* queue_task_new_cached(int task_id, const char *ref_description, int priority);
+
+/**
+ * Release the task's description and payload and keep the struct for reuse
+ */
+void queue_task_free_cached(QueueTask *task);
+
+/**
+ * Move the calling thread's cached tasks to the depot (done automatically
+ * when a GThread exits)
+ */
+void queue_task_cache_flush(void);
+
+/**
+ * Flush the calling thread's cache and free every task held by the depot
+ */
+void queue_task_cache_trim(void);
+
+void queue_task_cache_get_stats(QueueTaskCacheStats *stats);
+
+#endif /* TASK_CACHE_H */
@@ -0,0 +1,340 @@
+#include "task_pool.h"
+#include <stdatomic.h>
+
+#define TASK_DEQUE_MIN_CAPACITY 64
+#define TASK_POOL_CACHE_LINE 64
+
+/**
+ * Growable circular deque of tasks. The owning worker pushes and pops at
+ * the bottom (newest end); thieves take from the top (oldest end).
+ */
+typedef struct {
+    GMutex lock;
+    QueueTask **tasks;
+    guint head;             /* index of the oldest task */
+    guint length;
+    guint capacity;         /* power of two */
+} TaskDeque;
+
+typedef struct {
+    TaskPool *pool;
+    GThread *thread;
+    guint index;
+    guint32 rng;            /* victim selection */
+    TaskDeque deque;
+    atomic_uint_fast64_t completed;
+    atomic_uint_fast64_t stolen;
+    char pad[TASK_POOL_CACHE_LINE];
+} TaskPoolWorker;
+
+struct _TaskPool {
+    TaskPoolFunc func;
+    gpointer user_data;
+    TaskPoolWorker *workers;
+    guint n_workers;
+
+    atomic_uint next_worker;    /* round-robin target for external submissions */
+    atomic_int pending;         /* submitted, not yet taken by a worker */
+    atomic_int outstanding;     /* submitted, not yet finished */
+    atomic_int idle;            /* workers asleep or about to sleep */
+
+    GMutex lock;
+    GCond work_cond;
+    GCond done_cond;
+    gboolean shutdown;          /* protected by lock */
+};
+
+// Worker running on the current thread, if any
+static GPrivate current_worker = G_PRIVATE_INIT(NULL);
+
+/* =============================================================================
+ * Deque
+ * ============================================================================= */
+
+static void task_deque_init(TaskDeque *deque) {
+    g_mutex_init(&deque->lock);
+    deque->capacity = TASK_DEQUE_MIN_CAPACITY;
+    deque->tasks = g_new(QueueTask*, deque->capacity);
+    deque->head = 0;
+    deque->length = 0;
+}
+
+static void task_deque_clear(TaskDeque *deque) {
+    g_free(deque->tasks);
+    g_mutex_clear(&deque->lock);
+}
+
+// Append at the bottom; the deque must be locked
+static void task_deque_push_locked(TaskDeque *deque, QueueTask *task) {
+    if (deque->length == deque->capacity) {
+        guint new_capacity = deque->capacity * 2;
+        QueueTask **tasks = g_new(QueueTask*, new_capacity);
+        for (guint i = 0; i < deque->length; i++) {
+            tasks[i] = deque->tasks[(deque->head + i) & (deque->capacity - 1)];
+        }
+        g_free(deque->tasks);
+        deque->tasks = tasks;
+        deque->capacity = new_capacity;
+        deque->head = 0;
+    }
+    deque->tasks[(deque->head + deque->length) & (deque->capacity - 1)] = task;
+    deque->length++;
+}
+
+static void task_deque_push(TaskDeque *deque, QueueTask *task) {
+    g_mutex_lock(&deque->lock);
+    task_deque_push_locked(deque, task);
+    g_mutex_unlock(&deque->lock);
+}
+
+static QueueTask* task_deque_pop_bottom(TaskDeque *deque) {
+    QueueTask *task = NULL;
+    g_mutex_lock(&deque->lock);
+    if (deque->length > 0) {
+        deque->length--;
+        task = deque->tasks[(deque->head + deque->length) & (deque->capacity - 1)];
+    }
+    g_mutex_unlock(&deque->lock);
+    return task;
+}
+
+// Take the oldest half (at least one) of the deque into out; returns the count
+static guint task_deque_steal_half(TaskDeque *deque, QueueTask **out, guint max_tasks) {
+    g_mutex_lock(&deque->lock);
+    guint n = MIN((deque->length + 1) / 2, max_tasks);
+    for (guint i = 0; i < n; i++) {
+        out[i] = deque->tasks[deque->head];
+        deque->head = (deque->head + 1) & (deque->capacity - 1);
+    }
+    deque->length -= n;
+    g_mutex_unlock(&deque->lock);
+    return n;
+}
+
+/* =============================================================================
+ * Workers
+ * ============================================================================= */
+
+#define TASK_POOL_STEAL_BATCH 32
+
+static QueueTask* task_pool_steal(TaskPool *pool, TaskPoolWorker *thief) {
+    if (pool->n_workers < 2) {
+        return NULL;
+    }
+
+    // xorshift32: start each scan at a random victim to spread thieves out
+    thief->rng ^= thief->rng << 13;
+    thief->rng ^= thief->rng >> 17;
+    thief->rng ^= thief->rng << 5;
+    guint start = thief->rng % pool->n_workers;
+
+    for (guint i = 0; i < pool->n_workers; i++) {
+        TaskPoolWorker *victim = &pool->workers[(start + i) % pool->n_workers];
+        if (victim == thief) {
+            continue;
+        }
+
+        QueueTask *batch[TASK_POOL_STEAL_BATCH];
+        guint n = task_deque_steal_half(&victim->deque, batch, TASK_POOL_STEAL_BATCH);
+        if (n == 0) {
+            continue;
+        }
+
+        // Run the oldest stolen task now and keep the rest locally
+        if (n > 1) {
+            g_mutex_lock(&thief->deque.lock);
+            for (guint j = 1; j < n; j++) {
+                task_deque_push_locked(&thief->deque, batch[j]);
+            }
+            g_mutex_unlock(&thief->deque.lock);
+        }
+        atomic_fetch_add_explicit(&thief->stolen, n, memory_order_relaxed);
+        return batch[0];
+    }
+    return NULL;
+}
+
+// Sleep until work may be available; FALSE once the pool is shut down and drained
+static gboolean task_pool_idle(TaskPool *pool) {
+    gboolean keep_running = TRUE;
+
+    g_mutex_lock(&pool->lock);
+    // Announce ourselves before re-checking pending; task_pool_push() does
+    // the reverse, so one of the two always sees the other
+    atomic_fetch_add(&pool->idle, 1);
+    while (atomic_load(&pool->pending) == 0 && !pool->shutdown) {
+        g_cond_wait(&pool->work_cond, &pool->lock);
+    }
+    atomic_fetch_sub(&pool->idle, 1);
+    if (pool->shutdown && atomic_load(&pool->pending) == 0) {
+        keep_running = FALSE;
+    }
+    g_mutex_unlock(&pool->lock);
+
+    return keep_running;
+}
+
+static gpointer task_pool_worker_main(gpointer data) {
+    TaskPoolWorker *worker = (TaskPoolWorker*)data;
+    TaskPool *pool = worker->pool;
+
+    g_private_set(&current_worker, worker);
+
+    while (TRUE) {
+        QueueTask *task = task_deque_pop_bottom(&worker->deque);
+        if (!task) {
+            task = task_pool_steal(pool, worker);
+        }
+
+        if (task) {
+            atomic_fetch_sub(&pool->pending, 1);
+            pool->func(task, pool->user_data);
+            atomic_fetch_add_explicit(&worker->completed, 1, memory_order_relaxed);
+
+            if (atomic_fetch_sub(&pool->outstanding, 1) == 1) {
+                g_mutex_lock(&pool->lock);
+                g_cond_broadcast(&pool->done_cond);
+                g_mutex_unlock(&pool->lock);
+            }
+            continue;
+        }
+
+        if (!task_pool_idle(pool)) {
+            break;
+        }
+    }
+
+    g_private_set(&current_worker, NULL);
+    return NULL;
+}
+
+/* =============================================================================
+ * Pool
+ * ============================================================================= */
+
+TaskPool* task_pool_new(guint n_workers, TaskPoolFunc func, gpointer user_data) {
+    g_return_val_if_fail(func != NULL, NULL);
+
+    if (n_workers == 0) {
+        n_workers = MAX(g_get_num_processors(), 1);
+    }
+
+    TaskPool *pool = g_new0(TaskPool, 1);
+    pool->func = func;
+    pool->user_data = user_data;
+    pool->n_workers = n_workers;
+    atomic_init(&pool->next_worker, 0);
+    atomic_init(&pool->pending, 0);
+    atomic_init(&pool->outstanding, 0);
+    atomic_init(&pool->idle, 0);
+    g_mutex_init(&pool->lock);
+    g_cond_init(&pool->work_cond);
+    g_cond_init(&pool->done_cond);
+    pool->shutdown = FALSE;
+
+    // Initialize every deque before any worker can try to steal from it
+    pool->workers = g_new0(TaskPoolWorker, n_workers);
+    for (guint i = 0; i < n_workers; i++) {
+        TaskPoolWorker *worker = &pool->workers[i];
+        worker->pool = pool;
+        worker->index = i;
+        worker->rng = 0x9e3779b9u * (i + 1);
+        task_deque_init(&worker->deque);
+        atomic_init(&worker->completed, 0);
+        atomic_init(&worker->stolen, 0);
+    }
+
+    for (guint i = 0; i < n_workers; i++) {
+        char name[16];
+        g_snprintf(name, sizeof(name), "task-pool-%u", i);
+        pool->workers[i].thread = g_thread_new(name, task_pool_worker_main, &pool->workers[i]);
+    }
+
+    return pool;
+}
+
+void task_pool_free(TaskPool *pool) {
+    if (!pool) {
+        return;
+    }
+
+    g_mutex_lock(&pool->lock);
+    pool->shutdown = TRUE;
+    g_cond_broadcast(&pool->work_cond);
+    g_mutex_unlock(&pool->lock);
+
+    for (guint i = 0; i < pool->n_workers; i++) {
+        g_thread_join(pool->workers[i].thread);
+        task_deque_clear(&pool->workers[i].deque);
+    }
+
+    g_cond_clear(&pool->done_cond);
+    g_cond_clear(&pool->work_cond);
+    g_mutex_clear(&pool->lock);
+    g_free(pool->workers);
+    g_free(pool);
+}
+
+void task_pool_push(TaskPool *pool, QueueTask *task) {
+    g_return_if_fail(pool != NULL && task != NULL);
+
+    TaskPoolWorker *self = g_private_get(&current_worker);
+    TaskPoolWorker *target;
+    if (self && self->pool == pool) {
+        target = self;
+    } else {
+        guint next = atomic_fetch_add_explicit(&pool->next_worker, 1, memory_order_relaxed);
+        target = &pool->workers[next % pool->n_workers];
+    }
+
+    // Count the task before it becomes visible so pending never underflows
+    atomic_fetch_add(&pool->outstanding, 1);
+    atomic_fetch_add(&pool->pending, 1);
+    task_deque_push(&target->deque, task);
+
+    if (atomic_load(&pool->idle) > 0) {
+        g_mutex_lock(&pool->lock);
+        g_cond_signal(&pool->work_cond);
+        g_mutex_unlock(&pool->lock);
+    }
+}
+
+void task_pool_wait(TaskPool *pool) {
+    g_return_if_fail(pool != NULL);
+
+    g_mutex_lock(&pool->lock);
+    while (atomic_load(&pool->outstanding) > 0) {
+        g_cond_wait(&pool->done_cond, &pool->lock);
+    }
+    g_mutex_unlock(&pool->lock);
+}
+
+guint task_pool_get_num_workers(TaskPool *pool) {
+    g_return_val_if_fail(pool != NULL, 0);
+    return pool->n_workers;
+}
+
+guint task_pool_get_pending(TaskPool *pool) {
+    g_return_val_if_fail(pool != NULL, 0);
+    return (guint)MAX(atomic_load(&pool->pending), 0);
+}
+
+guint64 task_pool_get_completed(TaskPool *pool) {
+    g_return_val_if_fail(pool != NULL, 0);
+
+    guint64 total = 0;
+    for (guint i = 0; i < pool->n_workers; i++) {
+        total += atomic_load_explicit(&pool->workers[i].completed, memory_order_relaxed);
+    }
+    return total;
+}
+
+guint64 task_pool_get_stolen(TaskPool *pool) {
+    g_return_val_if_fail(pool != NULL, 0);
+
+    guint64 total = 0;
+    for (guint i = 0; i < pool->n_workers; i++) {
+        total += atomic_load_explicit(&pool->workers[i].stolen, memory_order_relaxed);
+    }
+    return total;
+}
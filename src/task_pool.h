@@ -0,0 +1,56 @@
+#ifndef TASK_POOL_H
+#define TASK_POOL_H
+
+#include <glib.h>
+#include "test_async_queue.h"
+
+/**
+ * Work-stealing thread pool for QueueTask processing.
+ *
+ * - one worker per processor by default (g_get_num_processors())
+ * - every worker owns a deque: it takes its own work newest-first and,
+ *   when that runs dry, steals the oldest half of another worker's deque
+ * - tasks submitted from outside the pool are spread round-robin over the
+ *   workers; tasks submitted from inside a work function stay on the
+ *   submitting worker's deque
+ * - idle workers sleep and are woken only when work arrives
+ * - task_pool_free() drains the queued tasks and joins the workers; no
+ *   TERMINATE task is needed
+ */
+typedef struct _TaskPool TaskPool;
+
+/**
+ * Called on a worker thread for every submitted task. The function owns
+ * the task (e.g. frees it with queue_task_free()).
+ */
+typedef void (*TaskPoolFunc)(QueueTask *task, gpointer user_data);
+
+/**
+ * Create a pool of n_workers threads (0 = one per processor)
+ */
+TaskPool* task_pool_new(guint n_workers, TaskPoolFunc func, gpointer user_data);
+
+/**
+ * Run every task already submitted, then stop the workers and free the pool
+ */
+void task_pool_free(TaskPool *pool);
+
+/**
+ * Submit a task; safe to call from any thread, including from func
+ */
+void task_pool_push(TaskPool *pool, QueueTask *task);
+
+/**
+ * Block until every task submitted so far has been processed
+ */
+void task_pool_wait(TaskPool *pool);
+
+/**
+ * Pool information and counters
+ */
+guint task_pool_get_num_workers(TaskPool *pool);
+guint task_pool_get_pending(TaskPool *pool);
+guint64 task_pool_get_completed(TaskPool *pool);
+guint64 task_pool_get_stolen(TaskPool *pool);
+
+#endif /* TASK_POOL_H */
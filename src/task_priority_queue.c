@@ -0,0 +1,315 @@
+#include "task_priority_queue.h"
+#include <stdio.h>
+#include <string.h>
+
+/* Lanes 0-2 hold priorities 1-3; the last lane holds everything else */
+#define BACKGROUND_LANE TASK_PRIORITY_LEVELS
+#define LANE_COUNT (TASK_PRIORITY_LEVELS + 1)
+#define LANE_MIN_CAPACITY 16
+#define DEFAULT_MAX_WAIT_US 100000
+
+typedef struct {
+    QueueTask *task;
+    gint64 enqueued_us;
+} PriorityEntry;
+
+/**
+ * Growable circular FIFO of one priority
+ */
+typedef struct {
+    PriorityEntry *entries;
+    guint head;
+    guint length;
+    guint capacity;         /* power of two */
+    guint weight;
+    guint credit;           /* pops left in the current round-robin round */
+    TaskLaneStats stats;
+} PriorityLane;
+
+struct _TaskPriorityQueue {
+    GMutex lock;
+    GCond not_empty;
+    guint length;
+    gint64 max_wait_us;
+    gboolean promotion_left;    /* one starvation promotion per round-robin round */
+    PriorityLane lanes[LANE_COUNT];
+};
+
+static const guint default_weights[TASK_PRIORITY_LEVELS] = { 4, 2, 1 };
+
+/* =============================================================================
+ * Lanes
+ * ============================================================================= */
+
+static void lane_push(PriorityLane *lane, QueueTask *task, gint64 now) {
+    if (lane->length == lane->capacity) {
+        guint new_capacity = lane->capacity ? lane->capacity * 2 : LANE_MIN_CAPACITY;
+        PriorityEntry *entries = g_new(PriorityEntry, new_capacity);
+        // Unwrap into the new array so head starts at 0
+        for (guint i = 0; i < lane->length; i++) {
+            entries[i] = lane->entries[(lane->head + i) & (lane->capacity - 1)];
+        }
+        g_free(lane->entries);
+        lane->entries = entries;
+        lane->capacity = new_capacity;
+        lane->head = 0;
+    }
+
+    PriorityEntry *entry = &lane->entries[(lane->head + lane->length) & (lane->capacity - 1)];
+    entry->task = task;
+    entry->enqueued_us = now;
+    lane->length++;
+}
+
+static inline PriorityEntry* lane_peek(PriorityLane *lane) {
+    return &lane->entries[lane->head];
+}
+
+static PriorityEntry lane_pop(PriorityLane *lane) {
+    PriorityEntry entry = lane->entries[lane->head];
+    lane->head = (lane->head + 1) & (lane->capacity - 1);
+    lane->length--;
+    return entry;
+}
+
+static int lane_index_for_priority(int priority) {
+    if (priority < 1 || priority > TASK_PRIORITY_LEVELS) {
+        return BACKGROUND_LANE;
+    }
+    return priority - 1;
+}
+
+/* =============================================================================
+ * Queue
+ * ============================================================================= */
+
+TaskPriorityQueue* task_priority_queue_new(void) {
+    TaskPriorityQueue *queue = g_new0(TaskPriorityQueue, 1);
+    g_mutex_init(&queue->lock);
+    g_cond_init(&queue->not_empty);
+    queue->max_wait_us = DEFAULT_MAX_WAIT_US;
+    queue->promotion_left = TRUE;
+    task_priority_queue_set_weights(queue, default_weights);
+    return queue;
+}
+
+void task_priority_queue_free(TaskPriorityQueue *queue) {
+    if (queue) {
+        for (int i = 0; i < LANE_COUNT; i++) {
+            g_free(queue->lanes[i].entries);
+        }
+        g_cond_clear(&queue->not_empty);
+        g_mutex_clear(&queue->lock);
+        g_free(queue);
+    }
+}
+
+void task_priority_queue_set_weights(TaskPriorityQueue *queue, const guint weights[TASK_PRIORITY_LEVELS]) {
+    g_return_if_fail(queue != NULL && weights != NULL);
+
+    g_mutex_lock(&queue->lock);
+    for (int i = 0; i < TASK_PRIORITY_LEVELS; i++) {
+        queue->lanes[i].weight = MAX(weights[i], 1);
+        queue->lanes[i].credit = queue->lanes[i].weight;
+    }
+    g_mutex_unlock(&queue->lock);
+}
+
+void task_priority_queue_set_max_wait(TaskPriorityQueue *queue, gint64 max_wait_us) {
+    g_return_if_fail(queue != NULL);
+
+    g_mutex_lock(&queue->lock);
+    queue->max_wait_us = MAX(max_wait_us, 0);
+    g_mutex_unlock(&queue->lock);
+}
+
+void task_priority_queue_push(TaskPriorityQueue *queue, QueueTask *task) {
+    g_return_if_fail(queue != NULL && task != NULL);
+
+    gint64 now = g_get_monotonic_time();
+    g_mutex_lock(&queue->lock);
+    lane_push(&queue->lanes[lane_index_for_priority(task->priority)], task, now);
+    queue->length++;
+    g_cond_signal(&queue->not_empty);
+    g_mutex_unlock(&queue->lock);
+}
+
+// Choose the lane to serve next; the queue must be locked and non-empty
+static int task_priority_queue_pick_lane(TaskPriorityQueue *queue, gint64 now) {
+    // Starvation protection: the lane whose head is most overdue goes first.
+    // Limited to one pop per round so an overloaded queue does not degrade
+    // into plain FIFO order.
+    if (queue->max_wait_us > 0 && queue->promotion_left) {
+        int overdue = -1;
+        gint64 oldest = now - queue->max_wait_us;
+        for (int i = 0; i < TASK_PRIORITY_LEVELS; i++) {
+            PriorityLane *lane = &queue->lanes[i];
+            if (lane->length > 0 && lane_peek(lane)->enqueued_us <= oldest) {
+                overdue = i;
+                oldest = lane_peek(lane)->enqueued_us;
+            }
+        }
+        if (overdue >= 0) {
+            queue->promotion_left = FALSE;
+            queue->lanes[overdue].stats.promoted++;
+            return overdue;
+        }
+    }
+
+    // Weighted round-robin: highest priority lane with credit left, refilling
+    // every lane's credit once the backlogged lanes have spent theirs
+    for (int round = 0; round < 2; round++) {
+        for (int i = 0; i < TASK_PRIORITY_LEVELS; i++) {
+            PriorityLane *lane = &queue->lanes[i];
+            if (lane->length > 0 && lane->credit > 0) {
+                lane->credit--;
+                return i;
+            }
+        }
+        for (int i = 0; i < TASK_PRIORITY_LEVELS; i++) {
+            queue->lanes[i].credit = queue->lanes[i].weight;
+        }
+        queue->promotion_left = TRUE;
+    }
+
+    return BACKGROUND_LANE;
+}
+
+// Pop from a locked, non-empty queue
+static QueueTask* task_priority_queue_pop_locked(TaskPriorityQueue *queue) {
+    gint64 now = g_get_monotonic_time();
+    int index = task_priority_queue_pick_lane(queue, now);
+    PriorityLane *lane = &queue->lanes[index];
+    PriorityEntry entry = lane_pop(lane);
+
+    queue->length--;
+    task_delay_histogram_record(&lane->stats.delay, (guint64)MAX(now - entry.enqueued_us, 0));
+    return entry.task;
+}
+
+QueueTask* task_priority_queue_pop(TaskPriorityQueue *queue) {
+    g_return_val_if_fail(queue != NULL, NULL);
+
+    g_mutex_lock(&queue->lock);
+    while (queue->length == 0) {
+        g_cond_wait(&queue->not_empty, &queue->lock);
+    }
+    QueueTask *task = task_priority_queue_pop_locked(queue);
+    g_mutex_unlock(&queue->lock);
+    return task;
+}
+
+QueueTask* task_priority_queue_try_pop(TaskPriorityQueue *queue) {
+    g_return_val_if_fail(queue != NULL, NULL);
+
+    QueueTask *task = NULL;
+    g_mutex_lock(&queue->lock);
+    if (queue->length > 0) {
+        task = task_priority_queue_pop_locked(queue);
+    }
+    g_mutex_unlock(&queue->lock);
+    return task;
+}
+
+QueueTask* task_priority_queue_timeout_pop(TaskPriorityQueue *queue, guint64 timeout_us) {
+    g_return_val_if_fail(queue != NULL, NULL);
+
+    gint64 end_time = g_get_monotonic_time() + (gint64)MIN(timeout_us, (guint64)G_MAXINT32 * G_USEC_PER_SEC);
+    QueueTask *task = NULL;
+
+    g_mutex_lock(&queue->lock);
+    while (queue->length == 0) {
+        if (!g_cond_wait_until(&queue->not_empty, &queue->lock, end_time)) {
+            break;
+        }
+    }
+    if (queue->length > 0) {
+        task = task_priority_queue_pop_locked(queue);
+    }
+    g_mutex_unlock(&queue->lock);
+    return task;
+}
+
+guint task_priority_queue_length(TaskPriorityQueue *queue) {
+    g_return_val_if_fail(queue != NULL, 0);
+
+    g_mutex_lock(&queue->lock);
+    guint length = queue->length;
+    g_mutex_unlock(&queue->lock);
+    return length;
+}
+
+guint task_priority_queue_lane_length(TaskPriorityQueue *queue, int priority) {
+    g_return_val_if_fail(queue != NULL, 0);
+    g_return_val_if_fail(priority >= 1 && priority <= TASK_PRIORITY_LEVELS, 0);
+
+    g_mutex_lock(&queue->lock);
+    guint length = queue->lanes[priority - 1].length;
+    g_mutex_unlock(&queue->lock);
+    return length;
+}
+
+/* =============================================================================
+ * Latency Statistics
+ * ============================================================================= */
+
+void task_priority_queue_get_stats(TaskPriorityQueue *queue, int priority, TaskLaneStats *out) {
+    g_return_if_fail(queue != NULL && out != NULL);
+    g_return_if_fail(priority >= 1 && priority <= TASK_PRIORITY_LEVELS);
+
+    g_mutex_lock(&queue->lock);
+    *out = queue->lanes[priority - 1].stats;
+    g_mutex_unlock(&queue->lock);
+}
+
+void task_priority_queue_reset_stats(TaskPriorityQueue *queue) {
+    g_return_if_fail(queue != NULL);
+
+    g_mutex_lock(&queue->lock);
+    for (int i = 0; i < LANE_COUNT; i++) {
+        memset(&queue->lanes[i].stats, 0, sizeof(TaskLaneStats));
+    }
+    g_mutex_unlock(&queue->lock);
+}
+
+void task_priority_queue_print_stats(TaskPriorityQueue *queue) {
+    g_return_if_fail(queue != NULL);
+
+    printf("\n--- Task Priority Queue Latency ---\n");
+    printf("%-9s %10s %10s %10s %10s %10s %9s\n",
+           "priority", "tasks", "mean (us)", "p50 (us)", "p99 (us)", "max (us)", "promoted");
+
+    for (int priority = 1; priority <= TASK_PRIORITY_LEVELS; priority++) {
+        TaskLaneStats stats;
+        task_priority_queue_get_stats(queue, priority, &stats);
+        printf("%-9d %10" G_GUINT64_FORMAT " %10" G_GUINT64_FORMAT " %10" G_GUINT64_FORMAT
+               " %10" G_GUINT64_FORMAT " %10" G_GUINT64_FORMAT " %9" G_GUINT64_FORMAT "\n",
+               priority, stats.delay.count,
+               stats.delay.count ? stats.delay.total_us / stats.delay.count : 0,
+               task_delay_histogram_percentile(&stats.delay, 0.50),
+               task_delay_histogram_percentile(&stats.delay, 0.99),
+               stats.delay.max_us, stats.promoted);
+    }
+}
+
+/* =============================================================================
+ * Producer/Consumer Transport
+ * ============================================================================= */
+
+static void task_priority_queue_transport_push(gpointer queue, QueueTask *task) {
+    task_priority_queue_push((TaskPriorityQueue*)queue, task);
+}
+
+static QueueTask* task_priority_queue_transport_pop(gpointer queue) {
+    return task_priority_queue_pop((TaskPriorityQueue*)queue);
+}
+
+static QueueTask* task_priority_queue_transport_timeout_pop(gpointer queue, guint64 timeout_us) {
+    return task_priority_queue_timeout_pop((TaskPriorityQueue*)queue, timeout_us);
+}
+
+const TaskTransport task_priority_queue_transport = {
+    .push = task_priority_queue_transport_push,
+    .pop = task_priority_queue_transport_pop,
+    .timeout_pop = task_priority_queue_transport_timeout_pop
+};
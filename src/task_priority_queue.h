@@ -0,0 +1,85 @@
+#ifndef TASK_PRIORITY_QUEUE_H
+#define TASK_PRIORITY_QUEUE_H
+
+#include <glib.h>
+#include "test_async_queue.h"
+
+/**
+ * Thread-safe QueueTask queue that honors QueueTask.priority.
+ *
+ * Tasks go into one FIFO lane per priority (1 = highest, 3 = lowest).
+ * Pops use weighted round-robin across the non-empty lanes, so with the
+ * default weights 4:2:1 a backlogged priority-1 lane gets 4 of every 7
+ * pops while lower lanes still make progress. On top of that, a lane whose
+ * oldest task has waited longer than the maximum wait is served next
+ * (starvation protection), at most once per round-robin round.
+ *
+ * Tasks with a priority outside 1-3, such as the TERMINATE task (priority
+ * 0), go to a background lane that is only served once every other lane is
+ * empty, so a termination task never overtakes real work.
+ *
+ * Every pop records the task's queueing delay in a per-priority histogram.
+ */
+typedef struct _TaskPriorityQueue TaskPriorityQueue;
+
+#define TASK_PRIORITY_LEVELS 3
+
+/**
+ * Statistics of one priority lane
+ */
+typedef struct {
+    TaskDelayHistogram delay;   /* queueing delay of every popped task */
+    guint64 promoted;           /* pops forced by starvation protection */
+} TaskLaneStats;
+
+/**
+ * Create a queue with weights 4:2:1 and a 100ms maximum wait
+ */
+TaskPriorityQueue* task_priority_queue_new(void);
+
+/**
+ * Free the queue. Tasks still queued are not freed.
+ */
+void task_priority_queue_free(TaskPriorityQueue *queue);
+
+/**
+ * Set the round-robin weights of priorities 1-3 (a weight of 0 counts as 1)
+ */
+void task_priority_queue_set_weights(TaskPriorityQueue *queue, const guint weights[TASK_PRIORITY_LEVELS]);
+
+/**
+ * Serve a lane first once its oldest task has waited max_wait_us; 0 disables
+ */
+void task_priority_queue_set_max_wait(TaskPriorityQueue *queue, gint64 max_wait_us);
+
+/**
+ * Queue operations, mirroring g_async_queue_push/pop/try_pop/timeout_pop
+ */
+void task_priority_queue_push(TaskPriorityQueue *queue, QueueTask *task);
+QueueTask* task_priority_queue_pop(TaskPriorityQueue *queue);
+QueueTask* task_priority_queue_try_pop(TaskPriorityQueue *queue);
+QueueTask* task_priority_queue_timeout_pop(TaskPriorityQueue *queue, guint64 timeout_us);
+
+/**
+ * Total queued tasks, and queued tasks of one priority (1-3)
+ */
+guint task_priority_queue_length(TaskPriorityQueue *queue);
+guint task_priority_queue_lane_length(TaskPriorityQueue *queue, int priority);
+
+/**
+ * Copy the statistics of one priority (1-3); reset clears all lanes
+ */
+void task_priority_queue_get_stats(TaskPriorityQueue *queue, int priority, TaskLaneStats *out);
+void task_priority_queue_reset_stats(TaskPriorityQueue *queue);
+
+/**
+ * Print per-priority counts, mean/p50/p99/max delay and promotions
+ */
+void task_priority_queue_print_stats(TaskPriorityQueue *queue);
+
+/**
+ * TaskPriorityQueue transport for producer_function/consumer_function
+ */
+extern const TaskTransport task_priority_queue_transport;
+
+#endif /* TASK_PRIORITY_QUEUE_H */
@@ -0,0 +1,345 @@
+#define _GNU_SOURCE
+
+#include "task_ring.h"
+#include <stdatomic.h>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+#define TASK_RING_MIN_CAPACITY 2
+/* Attempts made before a blocking call goes to sleep */
+#define TASK_RING_SPIN_LIMIT 128
+#define TASK_RING_CACHE_LINE 64
+
+typedef struct {
+    atomic_size_t sequence;     /* == position: free for that push; == position + 1: holds a task */
+    QueueTask *task;
+} TaskRingCell;
+
+/**
+ * Sleep/wake point for one ring condition ("not empty" or "not full").
+ * seq is the futex word: notifiers bump it so a waiter that is about to
+ * sleep on a stale value returns immediately instead of missing the wakeup.
+ */
+typedef struct {
+    _Atomic guint32 seq;
+    _Atomic guint32 waiters;
+#ifndef __linux__
+    GMutex lock;
+    GCond cond;
+#endif
+} TaskRingWait;
+
+struct _TaskRing {
+    TaskRingCell *cells;
+    gsize mask;
+
+    char pad0[TASK_RING_CACHE_LINE];
+    atomic_size_t enqueue_pos;
+    char pad1[TASK_RING_CACHE_LINE - sizeof(atomic_size_t)];
+    atomic_size_t dequeue_pos;
+    char pad2[TASK_RING_CACHE_LINE - sizeof(atomic_size_t)];
+
+    TaskRingWait not_empty;
+    TaskRingWait not_full;
+};
+
+/* =============================================================================
+ * Blocking Support
+ * ============================================================================= */
+
+static inline void task_ring_cpu_relax(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+static void task_ring_wait_init(TaskRingWait *wait) {
+    atomic_init(&wait->seq, 0);
+    atomic_init(&wait->waiters, 0);
+#ifndef __linux__
+    g_mutex_init(&wait->lock);
+    g_cond_init(&wait->cond);
+#endif
+}
+
+static void task_ring_wait_clear(TaskRingWait *wait) {
+#ifndef __linux__
+    g_mutex_clear(&wait->lock);
+    g_cond_clear(&wait->cond);
+#else
+    (void)wait;
+#endif
+}
+
+// Sleep while wait->seq still equals key; timeout_us < 0 waits forever
+static void task_ring_sleep(TaskRingWait *wait, guint32 key, gint64 timeout_us) {
+#ifdef __linux__
+    struct timespec ts, *tsp = NULL;
+    if (timeout_us >= 0) {
+        ts.tv_sec = timeout_us / G_USEC_PER_SEC;
+        ts.tv_nsec = (timeout_us % G_USEC_PER_SEC) * 1000;
+        tsp = &ts;
+    }
+    syscall(SYS_futex, (guint32*)&wait->seq, FUTEX_WAIT_PRIVATE, key, tsp, NULL, 0);
+#else
+    g_mutex_lock(&wait->lock);
+    if (atomic_load(&wait->seq) == key) {
+        if (timeout_us < 0) {
+            g_cond_wait(&wait->cond, &wait->lock);
+        } else {
+            g_cond_wait_until(&wait->cond, &wait->lock, g_get_monotonic_time() + timeout_us);
+        }
+    }
+    g_mutex_unlock(&wait->lock);
+#endif
+}
+
+// Announce a waiter; returns the key to sleep on. The caller must retry its
+// operation after this and before sleeping.
+static inline guint32 task_ring_prepare_wait(TaskRingWait *wait) {
+    guint32 key = atomic_load(&wait->seq);
+    atomic_fetch_add(&wait->waiters, 1);
+    atomic_thread_fence(memory_order_seq_cst);
+    return key;
+}
+
+static inline void task_ring_finish_wait(TaskRingWait *wait) {
+    atomic_fetch_sub(&wait->waiters, 1);
+}
+
+// Wake one waiter, if any. Pairs with the fence in task_ring_prepare_wait():
+// either the waiter sees our update on its retry, or we see its counter.
+static inline void task_ring_notify(TaskRingWait *wait) {
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(&wait->waiters, memory_order_relaxed) == 0) {
+        return;
+    }
+
+    atomic_fetch_add(&wait->seq, 1);
+#ifdef __linux__
+    syscall(SYS_futex, (guint32*)&wait->seq, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+#else
+    g_mutex_lock(&wait->lock);
+    g_cond_signal(&wait->cond);
+    g_mutex_unlock(&wait->lock);
+#endif
+}
+
+/* =============================================================================
+ * Ring Operations
+ * ============================================================================= */
+
+TaskRing* task_ring_new(guint capacity) {
+    gsize size = TASK_RING_MIN_CAPACITY;
+    while (size < capacity) {
+        size <<= 1;
+    }
+
+    TaskRing *ring = g_new0(TaskRing, 1);
+    ring->cells = g_new(TaskRingCell, size);
+    ring->mask = size - 1;
+
+    for (gsize i = 0; i < size; i++) {
+        atomic_init(&ring->cells[i].sequence, i);
+        ring->cells[i].task = NULL;
+    }
+    atomic_init(&ring->enqueue_pos, 0);
+    atomic_init(&ring->dequeue_pos, 0);
+    task_ring_wait_init(&ring->not_empty);
+    task_ring_wait_init(&ring->not_full);
+
+    return ring;
+}
+
+void task_ring_free(TaskRing *ring) {
+    if (ring) {
+        task_ring_wait_clear(&ring->not_empty);
+        task_ring_wait_clear(&ring->not_full);
+        g_free(ring->cells);
+        g_free(ring);
+    }
+}
+
+static gboolean task_ring_enqueue(TaskRing *ring, QueueTask *task) {
+    gsize pos = atomic_load_explicit(&ring->enqueue_pos, memory_order_relaxed);
+
+    while (TRUE) {
+        TaskRingCell *cell = &ring->cells[pos & ring->mask];
+        gsize seq = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+        gssize diff = (gssize)seq - (gssize)pos;
+
+        if (diff == 0) {
+            // Slot is free for this lap: claim it, then publish the task
+            if (atomic_compare_exchange_weak_explicit(&ring->enqueue_pos, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                cell->task = task;
+                atomic_store_explicit(&cell->sequence, pos + 1, memory_order_release);
+                return TRUE;
+            }
+            // CAS failure reloaded pos
+        } else if (diff < 0) {
+            // Slot still holds the task from the previous lap
+            return FALSE;
+        } else {
+            pos = atomic_load_explicit(&ring->enqueue_pos, memory_order_relaxed);
+        }
+    }
+}
+
+static QueueTask* task_ring_dequeue(TaskRing *ring) {
+    gsize pos = atomic_load_explicit(&ring->dequeue_pos, memory_order_relaxed);
+
+    while (TRUE) {
+        TaskRingCell *cell = &ring->cells[pos & ring->mask];
+        gsize seq = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+        gssize diff = (gssize)seq - (gssize)(pos + 1);
+
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&ring->dequeue_pos, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                QueueTask *task = cell->task;
+                // Hand the slot back to producers for the next lap
+                atomic_store_explicit(&cell->sequence, pos + ring->mask + 1, memory_order_release);
+                return task;
+            }
+        } else if (diff < 0) {
+            // Nothing published at this position yet
+            return NULL;
+        } else {
+            pos = atomic_load_explicit(&ring->dequeue_pos, memory_order_relaxed);
+        }
+    }
+}
+
+gboolean task_ring_try_push(TaskRing *ring, QueueTask *task) {
+    g_return_val_if_fail(ring != NULL && task != NULL, FALSE);
+
+    if (!task_ring_enqueue(ring, task)) {
+        return FALSE;
+    }
+    task_ring_notify(&ring->not_empty);
+    return TRUE;
+}
+
+QueueTask* task_ring_try_pop(TaskRing *ring) {
+    g_return_val_if_fail(ring != NULL, NULL);
+
+    QueueTask *task = task_ring_dequeue(ring);
+    if (task) {
+        task_ring_notify(&ring->not_full);
+    }
+    return task;
+}
+
+void task_ring_push(TaskRing *ring, QueueTask *task) {
+    g_return_if_fail(ring != NULL && task != NULL);
+
+    for (int spin = 0; spin < TASK_RING_SPIN_LIMIT; spin++) {
+        if (task_ring_try_push(ring, task)) {
+            return;
+        }
+        task_ring_cpu_relax();
+    }
+
+    while (TRUE) {
+        guint32 key = task_ring_prepare_wait(&ring->not_full);
+        gboolean pushed = task_ring_try_push(ring, task);
+        if (!pushed) {
+            task_ring_sleep(&ring->not_full, key, -1);
+        }
+        task_ring_finish_wait(&ring->not_full);
+        if (pushed) {
+            return;
+        }
+    }
+}
+
+// Shared by the blocking and timed pops; timeout_us < 0 waits forever
+static QueueTask* task_ring_pop_internal(TaskRing *ring, gint64 timeout_us) {
+    for (int spin = 0; spin < TASK_RING_SPIN_LIMIT; spin++) {
+        QueueTask *task = task_ring_try_pop(ring);
+        if (task) {
+            return task;
+        }
+        task_ring_cpu_relax();
+    }
+
+    gint64 deadline = timeout_us >= 0 ? g_get_monotonic_time() + timeout_us : -1;
+
+    while (TRUE) {
+        gint64 remaining = -1;
+        if (deadline >= 0) {
+            remaining = deadline - g_get_monotonic_time();
+            if (remaining <= 0) {
+                return task_ring_try_pop(ring);
+            }
+        }
+
+        guint32 key = task_ring_prepare_wait(&ring->not_empty);
+        QueueTask *task = task_ring_try_pop(ring);
+        if (!task) {
+            task_ring_sleep(&ring->not_empty, key, remaining);
+        }
+        task_ring_finish_wait(&ring->not_empty);
+        if (task) {
+            return task;
+        }
+    }
+}
+
+QueueTask* task_ring_pop(TaskRing *ring) {
+    g_return_val_if_fail(ring != NULL, NULL);
+    return task_ring_pop_internal(ring, -1);
+}
+
+QueueTask* task_ring_timeout_pop(TaskRing *ring, guint64 timeout_us) {
+    g_return_val_if_fail(ring != NULL, NULL);
+    return task_ring_pop_internal(ring, (gint64)MIN(timeout_us, (guint64)G_MAXINT64));
+}
+
+guint task_ring_length(TaskRing *ring) {
+    g_return_val_if_fail(ring != NULL, 0);
+
+    gsize tail = atomic_load_explicit(&ring->dequeue_pos, memory_order_relaxed);
+    gsize head = atomic_load_explicit(&ring->enqueue_pos, memory_order_relaxed);
+    gsize length = head - tail;
+    // The two loads are not a snapshot; clamp transient wrap-arounds
+    if ((gssize)length < 0) {
+        return 0;
+    }
+    return (guint)MIN(length, ring->mask + 1);
+}
+
+guint task_ring_get_capacity(TaskRing *ring) {
+    g_return_val_if_fail(ring != NULL, 0);
+    return (guint)(ring->mask + 1);
+}
+
+/* =============================================================================
+ * Producer/Consumer Transport
+ * ============================================================================= */
+
+static void task_ring_transport_push(gpointer queue, QueueTask *task) {
+    task_ring_push((TaskRing*)queue, task);
+}
+
+static QueueTask* task_ring_transport_pop(gpointer queue) {
+    return task_ring_pop((TaskRing*)queue);
+}
+
+static QueueTask* task_ring_transport_timeout_pop(gpointer queue, guint64 timeout_us) {
+    return task_ring_timeout_pop((TaskRing*)queue, timeout_us);
+}
+
+const TaskTransport task_ring_transport = {
+    .push = task_ring_transport_push,
+    .pop = task_ring_transport_pop,
+    .timeout_pop = task_ring_transport_timeout_pop
+};
@@ -0,0 +1,65 @@
+#ifndef TASK_RING_H
+#define TASK_RING_H
+
+#include <glib.h>
+#include "test_async_queue.h"
+
+/**
+ * Bounded multi-producer/multi-consumer ring of QueueTask pointers.
+ *
+ * An alternative to GAsyncQueue for the producer/consumer threads:
+ * - fixed power-of-two slot array, no per-push node allocation
+ * - Vyukov-style per-slot sequence numbers: producers and consumers claim
+ *   slots with one compare-and-swap each and never take a lock
+ * - the producer and consumer cursors live on separate cache lines
+ *
+ * The try_* calls never block. The blocking calls spin briefly and then
+ * sleep on a futex (Linux) or a GCond (elsewhere) until a slot or task
+ * becomes available; threads are only woken when somebody is waiting.
+ */
+typedef struct _TaskRing TaskRing;
+
+/**
+ * Create a ring holding at least capacity tasks (rounded up to a power of two)
+ */
+TaskRing* task_ring_new(guint capacity);
+
+/**
+ * Free the ring. Tasks still queued are not freed.
+ */
+void task_ring_free(TaskRing *ring);
+
+/**
+ * Non-blocking push and pop; return FALSE/NULL when the ring is full/empty
+ */
+gboolean task_ring_try_push(TaskRing *ring, QueueTask *task);
+QueueTask* task_ring_try_pop(TaskRing *ring);
+
+/**
+ * Push, waiting while the ring is full
+ */
+void task_ring_push(TaskRing *ring, QueueTask *task);
+
+/**
+ * Pop, waiting while the ring is empty
+ */
+QueueTask* task_ring_pop(TaskRing *ring);
+
+/**
+ * Pop, waiting up to timeout_us microseconds; NULL on timeout
+ */
+QueueTask* task_ring_timeout_pop(TaskRing *ring, guint64 timeout_us);
+
+/**
+ * Number of queued tasks (approximate while other threads are active)
+ */
+guint task_ring_length(TaskRing *ring);
+guint task_ring_get_capacity(TaskRing *ring);
+
+/**
+ * TaskRing transport for producer_function/consumer_function: set
+ * ThreadData.transport to it and ThreadData.transport_queue to the ring
+ */
+extern const TaskTransport task_ring_transport;
+
+#endif /* TASK_RING_H */
@@ -1,25 +1,75 @@
 #include "test_async_queue.h"
+#include "task_ring.h"
+#include "task_priority_queue.h"
+#include "task_pool.h"
+#include "task_cache.h"
+#include "task_bounded_queue.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>  // for sleep
 
-QueueTask* queue_task_new(int task_id, const char *description, int priority) {
+QueueTask* queue_task_new_take(int task_id, char *ref_description, int priority) {
     QueueTask *task = g_malloc(sizeof(QueueTask));
     task->task_id = task_id;
-    task->description = g_strdup(description);
+    task->description = ref_description;
     task->priority = priority;
     task->completed = FALSE;
+    task->enqueued_us = 0;
+    task->payload = NULL;
+    return task;
+}
+
+QueueTask* queue_task_new(int task_id, const char *description, int priority) {
+    return queue_task_new_take(task_id, g_ref_string_new(description), priority);
+}
+
+QueueTask* queue_task_new_shared(int task_id, const char *ref_description, int priority) {
+    return queue_task_new_take(task_id, g_ref_string_acquire((char*)ref_description), priority);
+}
+
+QueueTask* queue_task_new_in_arena(RecordArena *arena, int task_id, const char *description, int priority) {
+    gsize description_len = strlen(description) + 1;
+    
+    // One contiguous block: [QueueTask][description\0]
+    QueueTask *task = record_arena_alloc(arena, sizeof(QueueTask) + description_len);
+    task->task_id = task_id;
+    task->description = (char*)(task + 1);
+    task->priority = priority;
+    task->completed = FALSE;
+    task->enqueued_us = 0;
+    task->payload = NULL;
+    memcpy(task->description, description, description_len);
     return task;
 }
 
 void queue_task_free(QueueTask *task) {
     if (task) {
-        g_free(task->description);
+        g_ref_string_release(task->description);
+        if (task->payload) {
+            g_bytes_unref(task->payload);
+        }
         g_free(task);
     }
 }
 
+void queue_task_take_payload(QueueTask *task, GBytes *payload) {
+    g_return_if_fail(task != NULL);
+    
+    if (task->payload) {
+        g_bytes_unref(task->payload);
+    }
+    task->payload = payload;
+}
+
+GBytes* queue_task_steal_payload(QueueTask *task) {
+    g_return_val_if_fail(task != NULL, NULL);
+    
+    GBytes *payload = task->payload;
+    task->payload = NULL;
+    return payload;
+}
+
 void queue_task_print(QueueTask *task) {
     if (task) {
         printf("  Task #%d: %s (Priority: %d, Status: %s)\n", 
@@ -28,12 +78,202 @@ void queue_task_print(QueueTask *task) {
     }
 }
 
+void queue_task_simulate_work(QueueTask *task, gpointer user_data) {
+    (void)user_data;
+    // Higher priority = faster processing
+    g_usleep((4 - task->priority) * 1000000);  // 1-3 seconds
+}
+
+void task_delay_histogram_record(TaskDelayHistogram *histogram, guint64 delay_us) {
+    guint bucket = delay_us == 0 ? 0 : g_bit_storage(delay_us);
+    if (bucket >= TASK_DELAY_BUCKETS) {
+        bucket = TASK_DELAY_BUCKETS - 1;
+    }
+    histogram->buckets[bucket]++;
+    histogram->count++;
+    histogram->total_us += delay_us;
+    if (delay_us > histogram->max_us) {
+        histogram->max_us = delay_us;
+    }
+}
+
+void task_delay_histogram_merge(TaskDelayHistogram *dest, const TaskDelayHistogram *src) {
+    for (int i = 0; i < TASK_DELAY_BUCKETS; i++) {
+        dest->buckets[i] += src->buckets[i];
+    }
+    dest->count += src->count;
+    dest->total_us += src->total_us;
+    dest->max_us = MAX(dest->max_us, src->max_us);
+}
+
+guint64 task_delay_histogram_percentile(const TaskDelayHistogram *histogram, double q) {
+    g_return_val_if_fail(histogram != NULL, 0);
+    
+    if (histogram->count == 0) {
+        return 0;
+    }
+    
+    guint64 rank = (guint64)(q * (double)(histogram->count - 1)) + 1;
+    guint64 seen = 0;
+    for (int i = 0; i < TASK_DELAY_BUCKETS; i++) {
+        seen += histogram->buckets[i];
+        if (seen >= rank) {
+            guint64 upper = i == 0 ? 1 : (G_GUINT64_CONSTANT(1) << i);
+            return MIN(upper, histogram->max_us);
+        }
+    }
+    return histogram->max_us;
+}
+
+void task_run_stats_init(TaskRunStats *stats) {
+    memset(stats, 0, sizeof(TaskRunStats));
+    g_mutex_init(&stats->lock);
+    g_cond_init(&stats->cond);
+    stats->started_us = g_get_monotonic_time();
+}
+
+void task_run_stats_clear(TaskRunStats *stats) {
+    g_cond_clear(&stats->cond);
+    g_mutex_clear(&stats->lock);
+}
+
+// Count one completed task and wake anybody waiting for completions
+static void task_run_stats_complete(TaskRunStats *stats) {
+    g_atomic_int_inc(&stats->completed);
+    // Pairs with the waiters increment in task_run_stats_wait_completed()
+    if (g_atomic_int_get(&stats->waiters) > 0) {
+        g_mutex_lock(&stats->lock);
+        g_cond_broadcast(&stats->cond);
+        g_mutex_unlock(&stats->lock);
+    }
+}
+
+// Fold a consumer's private delay histogram into the run
+static void task_run_stats_report(TaskRunStats *stats, const TaskDelayHistogram *queue_delay) {
+    g_mutex_lock(&stats->lock);
+    task_delay_histogram_merge(&stats->queue_delay, queue_delay);
+    stats->finished_us = g_get_monotonic_time();
+    g_mutex_unlock(&stats->lock);
+}
+
+void task_run_stats_wait_completed(TaskRunStats *stats, gint n_tasks) {
+    g_return_if_fail(stats != NULL);
+    
+    g_mutex_lock(&stats->lock);
+    g_atomic_int_inc(&stats->waiters);
+    while (g_atomic_int_get(&stats->completed) < n_tasks) {
+        g_cond_wait(&stats->cond, &stats->lock);
+    }
+    g_atomic_int_add(&stats->waiters, -1);
+    g_mutex_unlock(&stats->lock);
+}
+
+void task_run_stats_print(TaskRunStats *stats) {
+    g_return_if_fail(stats != NULL);
+    
+    g_mutex_lock(&stats->lock);
+    gint completed = g_atomic_int_get(&stats->completed);
+    gint64 end_us = stats->finished_us ? stats->finished_us : g_get_monotonic_time();
+    double elapsed = (double)(end_us - stats->started_us) / G_USEC_PER_SEC;
+    TaskDelayHistogram delay = stats->queue_delay;
+    g_mutex_unlock(&stats->lock);
+    
+    printf("\n--- Task Run Statistics ---\n");
+    printf("Completed: %d tasks in %.3f s (%.0f tasks/sec)\n",
+           completed, elapsed, elapsed > 0 ? completed / elapsed : 0.0);
+    printf("Queueing delay (us): mean %" G_GUINT64_FORMAT ", p50 %" G_GUINT64_FORMAT
+           ", p99 %" G_GUINT64_FORMAT ", max %" G_GUINT64_FORMAT "\n",
+           delay.count ? delay.total_us / delay.count : 0,
+           task_delay_histogram_percentile(&delay, 0.50),
+           task_delay_histogram_percentile(&delay, 0.99),
+           delay.max_us);
+}
+
+void task_queue_push_batch(GAsyncQueue *queue, QueueTask **tasks, guint n_tasks) {
+    g_return_if_fail(queue != NULL);
+    g_return_if_fail(tasks != NULL || n_tasks == 0);
+    
+    g_async_queue_lock(queue);
+    for (guint i = 0; i < n_tasks; i++) {
+        g_async_queue_push_unlocked(queue, tasks[i]);
+    }
+    g_async_queue_unlock(queue);
+}
+
+guint task_queue_pop_batch(GAsyncQueue *queue, QueueTask **out, guint max_tasks, gint64 timeout_us) {
+    g_return_val_if_fail(queue != NULL, 0);
+    g_return_val_if_fail(out != NULL, 0);
+    
+    if (max_tasks == 0) {
+        return 0;
+    }
+    
+    g_async_queue_lock(queue);
+    
+    // Only the first pop may block; the rest drain what is already queued
+    QueueTask *first;
+    if (timeout_us < 0) {
+        first = g_async_queue_pop_unlocked(queue);
+    } else if (timeout_us == 0) {
+        first = g_async_queue_try_pop_unlocked(queue);
+    } else {
+        first = g_async_queue_timeout_pop_unlocked(queue, (guint64)timeout_us);
+    }
+    
+    guint count = 0;
+    if (first) {
+        out[count++] = first;
+        while (count < max_tasks) {
+            QueueTask *task = g_async_queue_try_pop_unlocked(queue);
+            if (!task) {
+                break;
+            }
+            out[count++] = task;
+        }
+    }
+    
+    g_async_queue_unlock(queue);
+    return count;
+}
+
+static void async_queue_transport_push(gpointer queue, QueueTask *task) {
+    g_async_queue_push((GAsyncQueue*)queue, task);
+}
+
+static QueueTask* async_queue_transport_pop(gpointer queue) {
+    return (QueueTask*)g_async_queue_pop((GAsyncQueue*)queue);
+}
+
+static QueueTask* async_queue_transport_timeout_pop(gpointer queue, guint64 timeout_us) {
+    return (QueueTask*)g_async_queue_timeout_pop((GAsyncQueue*)queue, timeout_us);
+}
+
+const TaskTransport async_queue_transport = {
+    .push = async_queue_transport_push,
+    .pop = async_queue_transport_pop,
+    .timeout_pop = async_queue_transport_timeout_pop
+};
+
+// Resolve the transport and queue a producer/consumer thread should use
+static const TaskTransport* thread_data_transport(ThreadData *thread_data, gpointer *queue) {
+    if (thread_data->transport) {
+        *queue = thread_data->transport_queue;
+        return thread_data->transport;
+    }
+    *queue = thread_data->queue;
+    return &async_queue_transport;
+}
+
 gpointer producer_function(gpointer data) {
     ThreadData *thread_data = (ThreadData*)data;
-    GAsyncQueue *queue = thread_data->queue;
+    gpointer queue;
+    const TaskTransport *transport = thread_data_transport(thread_data, &queue);
     int num_tasks = thread_data->num_tasks;
+    gboolean verbose = !thread_data->quiet;
     
-    printf("[Producer] Starting to produce %d tasks...\n", num_tasks);
+    if (verbose) {
+        printf("[Producer] Starting to produce %d tasks...\n", num_tasks);
+    }
     
     // Sample task descriptions
     const char *task_descriptions[] = {
@@ -51,83 +291,129 @@ gpointer producer_function(gpointer data) {
     
     int num_descriptions = sizeof(task_descriptions) / sizeof(task_descriptions[0]);
     
+    // Tasks share one interned description each instead of a copy per task
+    char *shared_descriptions[G_N_ELEMENTS(task_descriptions)];
+    for (int i = 0; i < num_descriptions; i++) {
+        shared_descriptions[i] = g_ref_string_new_intern(task_descriptions[i]);
+    }
+    
     for (int i = 0; i < num_tasks; i++) {
         // Create a task with varying priority
         int priority = (i % 3) + 1;  // Priority 1-3
-        const char *desc = task_descriptions[i % num_descriptions];
+        const char *desc = shared_descriptions[i % num_descriptions];
         
-        QueueTask *task = queue_task_new(i + 1, desc, priority);
+        QueueTask *task = queue_task_new_cached(i + 1, desc, priority);
         
-        printf("[Producer] Creating task: ");
-        queue_task_print(task);
+        if (verbose) {
+            printf("[Producer] Creating task: ");
+            queue_task_print(task);
+        }
         
         // Add task to queue
-        g_async_queue_push(queue, task);
+        task->enqueued_us = g_get_monotonic_time();
+        transport->push(queue, task);
         
-        // Simulate work time
-        g_usleep(500000);  // 0.5 seconds
+        // Optional pacing between tasks
+        if (thread_data->produce_interval_us > 0) {
+            g_usleep(thread_data->produce_interval_us);
+        }
+    }
+    
+    // Queued tasks keep their own references
+    for (int i = 0; i < num_descriptions; i++) {
+        g_ref_string_release(shared_descriptions[i]);
     }
     
     // Send termination signal (use a special task instead of NULL)
-    QueueTask *termination_task = queue_task_new(-1, "TERMINATE", 0);
-    g_async_queue_push(queue, termination_task);
-    printf("[Producer] Finished producing tasks.\n");
+    if (!thread_data->external_terminate) {
+        QueueTask *termination_task = queue_task_new(-1, "TERMINATE", 0);
+        transport->push(queue, termination_task);
+    }
+    if (verbose) {
+        printf("[Producer] Finished producing tasks.\n");
+    }
     
     return NULL;
 }
 
 gpointer consumer_function(gpointer data) {
     ThreadData *thread_data = (ThreadData*)data;
-    GAsyncQueue *queue = thread_data->queue;
+    gpointer queue;
+    const TaskTransport *transport = thread_data_transport(thread_data, &queue);
     int processed_count = 0;
+    gboolean verbose = !thread_data->quiet;
+    TaskDelayHistogram queue_delay = { 0 };
     
-    printf("[Consumer] Starting to consume tasks...\n");
+    if (verbose) {
+        printf("[Consumer] Starting to consume tasks...\n");
+    }
     
     while (TRUE) {
         // Pop task from queue (blocks if queue is empty)
-        QueueTask *task = (QueueTask*)g_async_queue_pop(queue);
+        QueueTask *task = transport->pop(queue);
         
         // Check for termination signal
         if (task->task_id == -1) {
-            printf("[Consumer] Received termination signal.\n");
-            queue_task_free(task);
+            if (verbose) {
+                printf("[Consumer] Received termination signal.\n");
+            }
+            queue_task_free_cached(task);
             break;
         }
         
-        printf("[Consumer] Processing task: ");
-        queue_task_print(task);
+        if (thread_data->stats) {
+            task_delay_histogram_record(&queue_delay,
+                                        (guint64)MAX(g_get_monotonic_time() - task->enqueued_us, 0));
+        }
         
-        // Simulate processing time (higher priority = faster processing)
-        int processing_time = (4 - task->priority) * 1000000;  // 1-3 seconds
-        g_usleep(processing_time);
+        if (verbose) {
+            printf("[Consumer] Processing task: ");
+            queue_task_print(task);
+        }
+        
+        if (thread_data->work_func) {
+            thread_data->work_func(task, thread_data->work_data);
+        }
         
         // Mark task as completed
         task->completed = TRUE;
-        printf("[Consumer] Completed task: ");
-        queue_task_print(task);
+        if (verbose) {
+            printf("[Consumer] Completed task: ");
+            queue_task_print(task);
+        }
         
         processed_count++;
         
-        // Clean up task
-        queue_task_free(task);
+        // Clean up task; the struct stays in this thread's cache for reuse
+        queue_task_free_cached(task);
+        
+        if (thread_data->stats) {
+            task_run_stats_complete(thread_data->stats);
+        }
     }
     
-    printf("[Consumer] Finished processing %d tasks.\n", processed_count);
+    if (thread_data->stats) {
+        task_run_stats_report(thread_data->stats, &queue_delay);
+    }
+    if (verbose) {
+        printf("[Consumer] Finished processing %d tasks.\n", processed_count);
+    }
     return NULL;
 }
 
 // Timeout consumer that demonstrates timed operations
 gpointer timeout_consumer_function(gpointer data) {
     ThreadData *thread_data = (ThreadData*)data;
-    GAsyncQueue *queue = thread_data->queue;
+    gpointer queue;
+    const TaskTransport *transport = thread_data_transport(thread_data, &queue);
     int timeout_count = 0;
     int processed_count = 0;
     
     printf("[Timeout Consumer] Starting with 2-second timeout...\n");
     
-    while (!thread_data->stop_flag) {
+    while (!g_atomic_int_get(&thread_data->stop_flag)) {
         // Try to pop with timeout (2 seconds)
-        QueueTask *task = (QueueTask*)g_async_queue_timeout_pop(queue, 2000000);  // 2 seconds in microseconds
+        QueueTask *task = transport->timeout_pop(queue, 2000000);  // 2 seconds in microseconds
         
         if (task == NULL) {
             timeout_count++;
@@ -145,25 +431,117 @@ gpointer timeout_consumer_function(gpointer data) {
         
         // Check for termination
         if (task->task_id == -1) {
-            queue_task_free(task);
+            queue_task_free_cached(task);
             break;
         }
         
         printf("[Timeout Consumer] Processing task: ");
         queue_task_print(task);
         
-        // Quick processing
-        g_usleep(500000);  // 0.5 seconds
+        if (thread_data->work_func) {
+            thread_data->work_func(task, thread_data->work_data);
+        }
         task->completed = TRUE;
         processed_count++;
         
-        queue_task_free(task);
+        queue_task_free_cached(task);
+        
+        if (thread_data->stats) {
+            task_run_stats_complete(thread_data->stats);
+        }
     }
     
     printf("[Timeout Consumer] Processed %d tasks before timeout.\n", processed_count);
     return NULL;
 }
 
+void task_queue_run_load(const TaskTransport *transport, gpointer queue, int num_tasks,
+                         guint n_producers, guint n_consumers,
+                         TaskWorkFunc work_func, gpointer work_data, TaskRunStats *stats) {
+    g_return_if_fail(queue != NULL && n_producers > 0 && n_consumers > 0);
+    
+    ThreadData thread_data = {
+        .queue = transport ? NULL : queue,
+        .num_tasks = num_tasks,
+        .stop_flag = FALSE,
+        .transport = transport,
+        .transport_queue = transport ? queue : NULL,
+        .work_func = work_func,
+        .work_data = work_data,
+        .stats = stats,
+        .quiet = TRUE,
+        .external_terminate = TRUE
+    };
+    if (!transport) {
+        transport = &async_queue_transport;
+    }
+    
+    GThread **producers = g_new(GThread*, n_producers);
+    GThread **consumers = g_new(GThread*, n_consumers);
+    
+    for (guint i = 0; i < n_consumers; i++) {
+        consumers[i] = g_thread_new("load-consumer", consumer_function, &thread_data);
+    }
+    for (guint i = 0; i < n_producers; i++) {
+        producers[i] = g_thread_new("load-producer", producer_function, &thread_data);
+    }
+    for (guint i = 0; i < n_producers; i++) {
+        g_thread_join(producers[i]);
+    }
+    
+    // Everything is queued: one termination task per consumer ends the run
+    for (guint i = 0; i < n_consumers; i++) {
+        transport->push(queue, queue_task_new(-1, "TERMINATE", 0));
+    }
+    for (guint i = 0; i < n_consumers; i++) {
+        g_thread_join(consumers[i]);
+    }
+    
+    g_free(consumers);
+    g_free(producers);
+}
+
+// Processing step for the timeout demo
+static void timeout_demo_work(QueueTask *task, gpointer user_data) {
+    (void)task;
+    (void)user_data;
+    g_usleep(500000);  // 0.5 seconds
+}
+
+// Slow consumer for the back-pressure demo
+static void bounded_demo_work(QueueTask *task, gpointer user_data) {
+    (void)task;
+    (void)user_data;
+    g_usleep(50000);  // 0.05 seconds
+}
+
+static void on_bounded_queue_high(TaskBoundedQueue *queue, guint depth, gpointer user_data) {
+    (void)queue;
+    (void)user_data;
+    printf("[Bounded] High watermark: %u tasks queued, producer will block\n", depth);
+}
+
+static void on_bounded_queue_low(TaskBoundedQueue *queue, guint depth, gpointer user_data) {
+    (void)queue;
+    (void)user_data;
+    printf("[Bounded] Low watermark: drained to %u tasks\n", depth);
+}
+
+// Work function for the pool demo: same steps as consumer_function, shorter delays
+static void pool_process_task(QueueTask *task, gpointer user_data) {
+    (void)user_data;
+    
+    printf("[Pool] Processing task: ");
+    queue_task_print(task);
+    
+    g_usleep((4 - task->priority) * 100000);  // 0.1-0.3 seconds
+    task->completed = TRUE;
+    
+    printf("[Pool] Completed task: ");
+    queue_task_print(task);
+    queue_task_free(task);
+}
+
 void test_async_queue(void) {
     printf("\n=== GLib Async Queue Demo ===\n");
     
@@ -208,7 +586,9 @@ void test_async_queue(void) {
     ThreadData thread_data = {
         .queue = queue,
         .num_tasks = 5,
-        .stop_flag = FALSE
+        .stop_flag = FALSE,
+        .work_func = queue_task_simulate_work,
+        .produce_interval_us = 500000  // 0.5 seconds
     };
     
     // Create producer and consumer threads
@@ -233,17 +613,145 @@ void test_async_queue(void) {
     // Wait for producer to finish
     g_thread_join(producer2);
     
-    // Send termination signals for both consumers
-    QueueTask *term1 = queue_task_new(-1, "TERMINATE", 0);
+    // The producer sent one termination task; the second consumer needs its own
     QueueTask *term2 = queue_task_new(-1, "TERMINATE", 0);
-    g_async_queue_push(queue, term1);
     g_async_queue_push(queue, term2);
     
     // Wait for consumers to finish
     g_thread_join(consumer1);
     g_thread_join(consumer2);
     
-    printf("\n4. Timeout operations demo:\n");
+    printf("\n4. Throughput mode (no simulated delays):\n");
+    
+    // Same producer/consumer threads as a load generator: 2 x 50000 tasks
+    TaskRunStats load_stats;
+    task_run_stats_init(&load_stats);
+    task_queue_run_load(NULL, queue, 50000, 2, 2, NULL, NULL, &load_stats);
+    task_run_stats_print(&load_stats);
+    task_run_stats_clear(&load_stats);
+    
+    printf("\n5. Multiple consumers over a lock-free ring:\n");
+    
+    // Same producer/consumer functions, different transport
+    TaskRing *ring = task_ring_new(64);
+    ThreadData ring_data = {
+        .num_tasks = 4,
+        .stop_flag = FALSE,
+        .transport = &task_ring_transport,
+        .transport_queue = ring,
+        .work_func = queue_task_simulate_work,
+        .produce_interval_us = 500000
+    };
+    
+    GThread *ring_producer = g_thread_new("ring_producer", producer_function, &ring_data);
+    GThread *ring_consumer1 = g_thread_new("ring_consumer1", consumer_function, &ring_data);
+    GThread *ring_consumer2 = g_thread_new("ring_consumer2", consumer_function, &ring_data);
+    
+    g_thread_join(ring_producer);
+    
+    // The producer sent one termination task; the second consumer needs its own
+    task_ring_push(ring, queue_task_new(-1, "TERMINATE", 0));
+    
+    g_thread_join(ring_consumer1);
+    g_thread_join(ring_consumer2);
+    task_ring_free(ring);
+    
+    printf("\n6. Priority lanes:\n");
+    
+    // GAsyncQueue would hand these back in FIFO order
+    TaskPriorityQueue *priority_queue = task_priority_queue_new();
+    for (int i = 0; i < 6; i++) {
+        QueueTask *task = queue_task_new(301 + i, "Prioritized task", 3 - (i % 3));
+        printf("Queued: ");
+        queue_task_print(task);
+        task_priority_queue_push(priority_queue, task);
+    }
+    
+    QueueTask *next_task;
+    while ((next_task = task_priority_queue_try_pop(priority_queue)) != NULL) {
+        printf("Dequeued: ");
+        queue_task_print(next_task);
+        queue_task_free(next_task);
+    }
+    task_priority_queue_print_stats(priority_queue);
+    task_priority_queue_free(priority_queue);
+    
+    printf("\n7. Zero-copy payloads:\n");
+    
+    // A 1 MB buffer and an interned description travel by reference
+    gsize payload_size = 1024 * 1024;
+    GBytes *payload = g_bytes_new_take(g_malloc0(payload_size), payload_size);
+    char *report_name = g_ref_string_new_intern("Upload report");
+    
+    QueueTask *upload = queue_task_new_shared(501, report_name, 1);
+    queue_task_take_payload(upload, g_bytes_ref(payload));
+    g_async_queue_push(queue, upload);
+    
+    QueueTask *received = (QueueTask*)g_async_queue_pop(queue);
+    GBytes *received_payload = queue_task_steal_payload(received);
+    printf("Received task #%d with a %" G_GSIZE_FORMAT " byte payload\n",
+           received->task_id, g_bytes_get_size(received_payload));
+    printf("Same buffer: %s, same description string: %s\n",
+           g_bytes_get_data(received_payload, NULL) == g_bytes_get_data(payload, NULL) ? "yes" : "no",
+           received->description == report_name ? "yes" : "no");
+    
+    queue_task_free(received);
+    g_bytes_unref(received_payload);
+    g_bytes_unref(payload);
+    g_ref_string_release(report_name);
+    
+    printf("\n8. Work-stealing pool:\n");
+    
+    // One worker per processor; no consumer threads or TERMINATE tasks to manage
+    TaskPool *pool = task_pool_new(0, pool_process_task, NULL);
+    printf("Pool started with %u workers\n", task_pool_get_num_workers(pool));
+    
+    for (int i = 0; i < 8; i++) {
+        task_pool_push(pool, queue_task_new(401 + i, "Pooled task", (i % 3) + 1));
+    }
+    task_pool_wait(pool);
+    
+    printf("Pool completed %" G_GUINT64_FORMAT " tasks (%" G_GUINT64_FORMAT " stolen)\n",
+           task_pool_get_completed(pool), task_pool_get_stolen(pool));
+    task_pool_free(pool);
+    
+    printf("\n9. Bounded queue with back-pressure:\n");
+    
+    // A fast producer facing a slow consumer: the queue never holds more than 4 tasks
+    TaskBoundedQueue *bounded = task_bounded_queue_new(4);
+    task_bounded_queue_set_watermarks(bounded, 4, 1, on_bounded_queue_high, on_bounded_queue_low, NULL);
+    ThreadData bounded_data = {
+        .num_tasks = 12,
+        .stop_flag = FALSE,
+        .transport = &task_bounded_queue_transport,
+        .transport_queue = bounded,
+        .work_func = bounded_demo_work,
+        .quiet = TRUE
+    };
+    
+    GThread *bounded_producer = g_thread_new("bounded_producer", producer_function, &bounded_data);
+    GThread *bounded_consumer = g_thread_new("bounded_consumer", consumer_function, &bounded_data);
+    g_thread_join(bounded_producer);
+    g_thread_join(bounded_consumer);
+    
+    // Non-blocking producers get an answer instead of waiting
+    int rejected_tasks = 0;
+    for (int i = 0; i < 6; i++) {
+        QueueTask *task = queue_task_new(601 + i, "Optional task", 3);
+        if (!task_bounded_queue_try_push(bounded, task)) {
+            queue_task_free(task);
+            rejected_tasks++;
+        }
+    }
+    printf("try_push rejected %d of 6 tasks on a full queue\n", rejected_tasks);
+    while ((next_task = task_bounded_queue_try_pop(bounded)) != NULL) {
+        queue_task_free(next_task);
+    }
+    
+    task_bounded_queue_print_stats(bounded);
+    task_bounded_queue_free(bounded);
+    
+    printf("\n10. Timeout operations demo:\n");
     
     // Add a few tasks for timeout demo
     QueueTask *timeout_task1 = queue_task_new(201, "Timeout test task 1", 2);
@@ -252,17 +760,23 @@ void test_async_queue(void) {
     g_async_queue_push(queue, timeout_task1);
     g_async_queue_push(queue, timeout_task2);
     
-    thread_data.stop_flag = FALSE;
+    TaskRunStats timeout_stats;
+    task_run_stats_init(&timeout_stats);
+    thread_data.stats = &timeout_stats;
+    thread_data.work_func = timeout_demo_work;
+    g_atomic_int_set(&thread_data.stop_flag, FALSE);
     GThread *timeout_consumer = g_thread_new("timeout_consumer", 
                                             timeout_consumer_function, &thread_data);
     
-    // Let it run for a while
-    g_usleep(8000000);  // 8 seconds
-    thread_data.stop_flag = TRUE;
+    // Stop as soon as both tasks are done rather than after a fixed delay
+    task_run_stats_wait_completed(&timeout_stats, 2);
+    g_atomic_int_set(&thread_data.stop_flag, TRUE);
     
     g_thread_join(timeout_consumer);
+    thread_data.stats = NULL;
+    task_run_stats_clear(&timeout_stats);
     
-    printf("\n5. Interactive part - Add priority tasks:\n");
+    printf("\n11. Interactive part - Add priority tasks:\n");
     printf("You can add up to 3 tasks. Press Enter with empty description to stop.\n");
     
     int task_counter = 1000;
@@ -315,7 +829,14 @@ void test_async_queue(void) {
     }
     
     // Cleanup
-    printf("\n6. Cleaning up async queue...\n");
+    printf("\n12. Cleaning up async queue...\n");
     g_async_queue_unref(queue);
+    
+    QueueTaskCacheStats cache_stats;
+    queue_task_cache_get_stats(&cache_stats);
+    printf("Task cache: %" G_GUINT64_FORMAT " structs allocated, %" G_GUINT64_FORMAT
+           " magazines recycled through the depot\n",
+           cache_stats.allocated, cache_stats.depot_gets);
+    queue_task_cache_trim();
     printf("Async queue cleaned up successfully!\n");
 }
\ No newline at end of file
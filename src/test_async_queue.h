@@ -2,17 +2,52 @@
 #define ASYNC_QUEUE_H
 
 #include <glib.h>
+#include "record_arena.h"
 
 /**
  * Structure to represent a task for async queue demo
  */
 typedef struct {
     int task_id;
-    char *description;
+    char *description;      /* GRefString (plain arena memory for arena tasks) */
     int priority;
     gboolean completed;
+    gint64 enqueued_us;     /* monotonic time the producer queued the task */
+    GBytes *payload;        /* optional, owned by the task */
 } QueueTask;
 
+#define TASK_DELAY_BUCKETS 32
+
+/**
+ * Log2 histogram of queueing delays. Bucket 0 counts delays below 1us;
+ * bucket i > 0 counts delays in [2^(i-1), 2^i) microseconds.
+ */
+typedef struct {
+    guint64 count;
+    guint64 total_us;
+    guint64 max_us;
+    guint64 buckets[TASK_DELAY_BUCKETS];
+} TaskDelayHistogram;
+
+/**
+ * Per-task processing callback for the consumer threads. It must not free
+ * the task; the consumer does that afterwards.
+ */
+typedef void (*TaskWorkFunc)(QueueTask *task, gpointer user_data);
+
+/**
+ * Completion and latency accounting shared by the consumers of one run
+ */
+typedef struct {
+    GMutex lock;
+    GCond cond;
+    gint completed;             /* atomic */
+    gint waiters;               /* atomic */
+    gint64 started_us;
+    gint64 finished_us;         /* when the last consumer reported in */
+    TaskDelayHistogram queue_delay;
+} TaskRunStats;
+
 /**
  * Initialize and run async queue demonstration
  */
@@ -23,6 +58,36 @@ void test_async_queue(void);
  */
 QueueTask* queue_task_new(int task_id, const char *description, int priority);
 
+/**
+ * Create a new task whose struct and description share one arena block.
+ * The arena must outlive every consumer that can still pop the task, and the
+ * task must not be passed to queue_task_free().
+ */
+QueueTask* queue_task_new_in_arena(RecordArena *arena, int task_id, const char *description, int priority);
+
+/**
+ * Create a task sharing ref_description, a GRefString (g_ref_string_new()
+ * or g_ref_string_new_intern()); takes a new reference instead of copying
+ */
+QueueTask* queue_task_new_shared(int task_id, const char *ref_description, int priority);
+
+/**
+ * Create a task that takes over the caller's reference to the GRefString
+ * ref_description
+ */
+QueueTask* queue_task_new_take(int task_id, char *ref_description, int priority);
+
+/**
+ * Attach payload, replacing any previous one; the task takes over the
+ * caller's reference
+ */
+void queue_task_take_payload(QueueTask *task, GBytes *payload);
+
+/**
+ * Detach the payload and hand its reference to the caller (NULL if none)
+ */
+GBytes* queue_task_steal_payload(QueueTask *task);
+
 /**
  * Free task memory
  */
@@ -33,6 +98,48 @@ void queue_task_free(QueueTask *task);
  */
 void queue_task_print(QueueTask *task);
 
+/**
+ * Push n_tasks tasks taking the queue lock only once
+ */
+void task_queue_push_batch(GAsyncQueue *queue, QueueTask **tasks, guint n_tasks);
+
+/**
+ * Pop up to max_tasks tasks into out taking the queue lock only once.
+ * Waits for the first task: forever if timeout_us < 0, not at all if
+ * timeout_us == 0, otherwise for up to timeout_us microseconds. Returns the
+ * number of tasks stored in out (0 on timeout).
+ */
+guint task_queue_pop_batch(GAsyncQueue *queue, QueueTask **out, guint max_tasks, gint64 timeout_us);
+
+/**
+ * Record delay_us, merge two histograms, and read the upper bound (in
+ * microseconds) of the bucket holding quantile q (0.0-1.0)
+ */
+void task_delay_histogram_record(TaskDelayHistogram *histogram, guint64 delay_us);
+void task_delay_histogram_merge(TaskDelayHistogram *dest, const TaskDelayHistogram *src);
+guint64 task_delay_histogram_percentile(const TaskDelayHistogram *histogram, double q);
+
+/**
+ * The demo's simulated processing: sleeps (4 - priority) seconds
+ */
+void queue_task_simulate_work(QueueTask *task, gpointer user_data);
+
+/**
+ * Initialize run statistics; the run's clock starts here
+ */
+void task_run_stats_init(TaskRunStats *stats);
+void task_run_stats_clear(TaskRunStats *stats);
+
+/**
+ * Block until at least n_tasks tasks have completed
+ */
+void task_run_stats_wait_completed(TaskRunStats *stats, gint n_tasks);
+
+/**
+ * Print completed tasks, tasks/sec and queueing delay percentiles
+ */
+void task_run_stats_print(TaskRunStats *stats);
+
 /**
  * Producer function - adds tasks to queue
  */
@@ -43,6 +150,21 @@ gpointer producer_function(gpointer data);
  */
 gpointer consumer_function(gpointer data);
 
+/**
+ * Queue operations used by the producer/consumer threads, so the same
+ * thread functions can run over transports other than GAsyncQueue
+ */
+typedef struct {
+    void (*push)(gpointer queue, QueueTask *task);
+    QueueTask* (*pop)(gpointer queue);
+    QueueTask* (*timeout_pop)(gpointer queue, guint64 timeout_us);
+} TaskTransport;
+
+/**
+ * GAsyncQueue transport (the default when ThreadData.transport is NULL)
+ */
+extern const TaskTransport async_queue_transport;
+
 /**
  * Thread data structure
  */
@@ -50,6 +172,24 @@ typedef struct {
     GAsyncQueue *queue;
     int num_tasks;
     gboolean stop_flag;
+    const TaskTransport *transport;  /* NULL selects async_queue_transport */
+    gpointer transport_queue;        /* queue handed to a non-NULL transport */
+    TaskWorkFunc work_func;          /* per-task processing; NULL runs flat out */
+    gpointer work_data;
+    gulong produce_interval_us;      /* producer pause between tasks; 0 = none */
+    TaskRunStats *stats;             /* optional completion/latency accounting */
+    gboolean quiet;                  /* skip per-task output */
+    gboolean external_terminate;     /* producer leaves TERMINATE tasks to the caller */
 } ThreadData;
 
+/**
+ * Load generator: run n_producers producers of num_tasks tasks each and
+ * n_consumers consumers over transport (NULL = GAsyncQueue), calling
+ * work_func for every task with no simulated delays. Returns once every
+ * consumer has finished; stats receives throughput and queueing delay.
+ */
+void task_queue_run_load(const TaskTransport *transport, gpointer queue, int num_tasks,
+                         guint n_producers, guint n_consumers,
+                         TaskWorkFunc work_func, gpointer work_data, TaskRunStats *stats);
+
 #endif /* ASYNC_QUEUE_H */
\ No newline at end of file
@@ -12,6 +12,20 @@ ListPerson* list_person_new(const char *name, int age, const char *city) {
     return person;
 }
 
+ListPerson* list_person_new_in_arena(RecordArena *arena, const char *name, int age, const char *city) {
+    gsize name_len = strlen(name) + 1;
+    gsize city_len = strlen(city) + 1;
+    
+    // One contiguous block: [ListPerson][name\0][city\0]
+    ListPerson *person = record_arena_alloc(arena, sizeof(ListPerson) + name_len + city_len);
+    person->name = (char*)(person + 1);
+    person->age = age;
+    person->city = person->name + name_len;
+    memcpy(person->name, name, name_len);
+    memcpy(person->city, city, city_len);
+    return person;
+}
+
 void list_person_free(ListPerson *person) {
     if (person) {
         g_free(person->name);
@@ -56,6 +70,115 @@ gint find_person_by_name(gconstpointer a, gconstpointer b) {
     return g_strcmp0(person->name, name);
 }
 
+/* =============================================================================
+ * PersonVec - contiguous alternative to the GList person collection
+ * ============================================================================= */
+
+// Release the strings owned by an inline record (GArray clear function)
+static void list_person_clear(gpointer data) {
+    ListPerson *person = (ListPerson*)data;
+    g_free(person->name);
+    g_free(person->city);
+}
+
+PersonVec* person_vec_new(guint reserved_size) {
+    PersonVec *vec = g_malloc(sizeof(PersonVec));
+    vec->records = g_array_sized_new(FALSE, FALSE, sizeof(ListPerson), reserved_size);
+    g_array_set_clear_func(vec->records, list_person_clear);
+    return vec;
+}
+
+void person_vec_free(PersonVec *vec) {
+    if (vec) {
+        g_array_free(vec->records, TRUE);
+        g_free(vec);
+    }
+}
+
+ListPerson* person_vec_append(PersonVec *vec, const char *name, int age, const char *city) {
+    g_return_val_if_fail(vec != NULL, NULL);
+    
+    ListPerson person = { g_strdup(name), age, g_strdup(city) };
+    g_array_append_val(vec->records, person);
+    return &g_array_index(vec->records, ListPerson, vec->records->len - 1);
+}
+
+ListPerson* person_vec_insert(PersonVec *vec, guint index, const char *name, int age, const char *city) {
+    g_return_val_if_fail(vec != NULL, NULL);
+    
+    index = MIN(index, vec->records->len);
+    ListPerson person = { g_strdup(name), age, g_strdup(city) };
+    g_array_insert_val(vec->records, index, person);
+    return &g_array_index(vec->records, ListPerson, index);
+}
+
+void person_vec_remove_index(PersonVec *vec, guint index) {
+    g_return_if_fail(vec != NULL);
+    g_return_if_fail(index < vec->records->len);
+    
+    // Keeps the remaining records in order, like g_list_remove
+    g_array_remove_index(vec->records, index);
+}
+
+ListPerson* person_vec_index(PersonVec *vec, guint index) {
+    g_return_val_if_fail(vec != NULL, NULL);
+    
+    if (index >= vec->records->len) {
+        return NULL;
+    }
+    return &g_array_index(vec->records, ListPerson, index);
+}
+
+guint person_vec_length(PersonVec *vec) {
+    g_return_val_if_fail(vec != NULL, 0);
+    return vec->records->len;
+}
+
+gint person_vec_find_custom(PersonVec *vec, gconstpointer data, GCompareFunc func) {
+    g_return_val_if_fail(vec != NULL, -1);
+    
+    ListPerson *records = (ListPerson*)vec->records->data;
+    for (guint i = 0; i < vec->records->len; i++) {
+        if (func(&records[i], data) == 0) {
+            return (gint)i;
+        }
+    }
+    return -1;
+}
+
+void person_vec_sort(PersonVec *vec, GCompareFunc compare_func) {
+    g_return_if_fail(vec != NULL);
+    // The comparator receives pointers to the inline records, exactly like
+    // the ListPerson* data pointers handed over by g_list_sort
+    g_array_sort(vec->records, compare_func);
+}
+
+void person_vec_reverse(PersonVec *vec) {
+    g_return_if_fail(vec != NULL);
+    
+    ListPerson *records = (ListPerson*)vec->records->data;
+    guint len = vec->records->len;
+    for (guint i = 0; i < len / 2; i++) {
+        ListPerson tmp = records[i];
+        records[i] = records[len - 1 - i];
+        records[len - 1 - i] = tmp;
+    }
+}
+
+void person_vec_print_all(PersonVec *vec) {
+    printf("\n--- Current Vector Contents ---\n");
+    if (!vec || vec->records->len == 0) {
+        printf("  Vector is empty.\n");
+        return;
+    }
+    
+    for (guint i = 0; i < vec->records->len; i++) {
+        printf("%u. ", i + 1);
+        list_person_print(&g_array_index(vec->records, ListPerson, i));
+    }
+    printf("Total items: %u\n", vec->records->len);
+}
+
 void test_double_linked_lists(void) {
     printf("\n=== GLib Double Linked Lists Demo ===\n");
     
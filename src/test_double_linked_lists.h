@@ -2,6 +2,7 @@
 #define TEST_DOUBLE_LINKED_LISTS_H
 
 #include <glib.h>
+#include "record_arena.h"
 
 /**
  * Structure to represent a person for double linked lists demo
@@ -22,6 +23,13 @@ void test_double_linked_lists(void);
  */
 ListPerson* list_person_new(const char *name, int age, const char *city);
 
+/**
+ * Create a new person whose struct and strings share one arena block.
+ * The person is released by resetting or freeing the arena, never by
+ * list_person_free().
+ */
+ListPerson* list_person_new_in_arena(RecordArena *arena, const char *name, int age, const char *city);
+
 /**
  * Free person memory
  */
@@ -37,4 +45,42 @@ void list_person_print(ListPerson *person);
  */
 void list_print_all(GList *list);
 
+/**
+ * Comparison functions shared by the GList and PersonVec paths
+ */
+gint compare_persons_by_age(gconstpointer a, gconstpointer b);
+gint find_person_by_name(gconstpointer a, gconstpointer b);
+
+/**
+ * Contiguous person collection - a growable array of inline ListPerson
+ * records with O(1) amortized append and O(1) indexed access. Records are
+ * stored by value, so pointers returned by the accessors are only valid
+ * until the next append, insert or remove.
+ */
+typedef struct {
+    GArray *records;
+} PersonVec;
+
+PersonVec* person_vec_new(guint reserved_size);
+void person_vec_free(PersonVec *vec);
+
+ListPerson* person_vec_append(PersonVec *vec, const char *name, int age, const char *city);
+ListPerson* person_vec_insert(PersonVec *vec, guint index, const char *name, int age, const char *city);
+void person_vec_remove_index(PersonVec *vec, guint index);
+
+ListPerson* person_vec_index(PersonVec *vec, guint index);
+guint person_vec_length(PersonVec *vec);
+
+/**
+ * Return the index of the first record for which func(record, data) == 0,
+ * or -1 when no record matches. Unlike g_list_find_custom this returns an
+ * index rather than a node; func is called the same way, with the record
+ * as its first argument and data as its second.
+ */
+gint person_vec_find_custom(PersonVec *vec, gconstpointer data, GCompareFunc func);
+
+void person_vec_sort(PersonVec *vec, GCompareFunc compare_func);
+void person_vec_reverse(PersonVec *vec);
+void person_vec_print_all(PersonVec *vec);
+
 #endif /* TEST_DOUBLE_LINKED_LISTS_H */
\ No newline at end of file
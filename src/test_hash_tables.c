@@ -13,6 +13,22 @@ HashStudent* hash_student_new(const char *name, int student_id, double gpa, cons
     return student;
 }
 
+HashStudent* hash_student_new_in_arena(RecordArena *arena, const char *name, int student_id,
+                                       double gpa, const char *major) {
+    gsize name_len = strlen(name) + 1;
+    gsize major_len = strlen(major) + 1;
+    
+    // One contiguous block: [HashStudent][name\0][major\0]
+    HashStudent *student = record_arena_alloc(arena, sizeof(HashStudent) + name_len + major_len);
+    student->name = (char*)(student + 1);
+    student->student_id = student_id;
+    student->gpa = gpa;
+    student->major = student->name + name_len;
+    memcpy(student->name, name, name_len);
+    memcpy(student->major, major, major_len);
+    return student;
+}
+
 void hash_student_free(HashStudent *student) {
     if (student) {
         g_free(student->name);
@@ -54,6 +70,168 @@ void hash_table_print_all(GHashTable *table) {
     printf("Total entries: %d\n", g_hash_table_size(table));
 }
 
+/* =============================================================================
+ * StudentStore - hash table with secondary indexes
+ * ============================================================================= */
+
+// Order students by GPA; ties broken by ID and then address so keys are unique
+static gint compare_students_by_gpa(gconstpointer a, gconstpointer b, gpointer user_data) {
+    const HashStudent *student_a = (const HashStudent*)a;
+    const HashStudent *student_b = (const HashStudent*)b;
+    (void)user_data;
+    
+    if (student_a->gpa != student_b->gpa) {
+        return student_a->gpa < student_b->gpa ? -1 : 1;
+    }
+    if (student_a->student_id != student_b->student_id) {
+        return student_a->student_id < student_b->student_id ? -1 : 1;
+    }
+    return (student_a > student_b) - (student_a < student_b);
+}
+
+static GTree* gpa_index_new(void) {
+    return g_tree_new_full(compare_students_by_gpa, NULL, NULL, NULL);
+}
+
+StudentStore* student_store_new(void) {
+    StudentStore *store = g_malloc(sizeof(StudentStore));
+    store->by_key = g_hash_table_new_full(g_str_hash, g_str_equal, g_free,
+                                          (GDestroyNotify)hash_student_free);
+    store->by_major = g_hash_table_new_full(g_str_hash, g_str_equal, g_free,
+                                            (GDestroyNotify)g_tree_destroy);
+    store->by_gpa = gpa_index_new();
+    return store;
+}
+
+void student_store_free(StudentStore *store) {
+    if (store) {
+        // Indexes only reference students, so drop them before the owner
+        g_hash_table_destroy(store->by_major);
+        g_tree_destroy(store->by_gpa);
+        g_hash_table_destroy(store->by_key);
+        g_free(store);
+    }
+}
+
+static void student_store_index(StudentStore *store, HashStudent *student) {
+    GTree *major_index = g_hash_table_lookup(store->by_major, student->major);
+    if (!major_index) {
+        major_index = gpa_index_new();
+        g_hash_table_insert(store->by_major, g_strdup(student->major), major_index);
+    }
+    g_tree_insert(major_index, student, student);
+    g_tree_insert(store->by_gpa, student, student);
+}
+
+static void student_store_unindex(StudentStore *store, HashStudent *student) {
+    GTree *major_index = g_hash_table_lookup(store->by_major, student->major);
+    if (major_index) {
+        g_tree_remove(major_index, student);
+        if (g_tree_nnodes(major_index) == 0) {
+            g_hash_table_remove(store->by_major, student->major);
+        }
+    }
+    g_tree_remove(store->by_gpa, student);
+}
+
+void student_store_add(StudentStore *store, const char *key, HashStudent *student) {
+    g_return_if_fail(store != NULL);
+    g_return_if_fail(key != NULL && student != NULL);
+    g_return_if_fail(student->major != NULL);
+    
+    HashStudent *previous = g_hash_table_lookup(store->by_key, key);
+    if (previous == student) {
+        return;     // replacing would free the student being added
+    }
+    if (previous) {
+        student_store_unindex(store, previous);
+    }
+    
+    hash_table_add_student(store->by_key, key, student);
+    student_store_index(store, student);
+}
+
+gboolean student_store_remove(StudentStore *store, const char *key) {
+    g_return_val_if_fail(store != NULL, FALSE);
+    
+    HashStudent *student = g_hash_table_lookup(store->by_key, key);
+    if (!student) {
+        return FALSE;
+    }
+    
+    student_store_unindex(store, student);
+    return g_hash_table_remove(store->by_key, key);
+}
+
+HashStudent* student_store_lookup(StudentStore *store, const char *key) {
+    g_return_val_if_fail(store != NULL, NULL);
+    return g_hash_table_lookup(store->by_key, key);
+}
+
+gboolean student_store_update_gpa(StudentStore *store, const char *key, double gpa) {
+    g_return_val_if_fail(store != NULL, FALSE);
+    
+    HashStudent *student = g_hash_table_lookup(store->by_key, key);
+    if (!student) {
+        return FALSE;
+    }
+    
+    // Re-position the student in both ordered indexes
+    student_store_unindex(store, student);
+    student->gpa = gpa;
+    student_store_index(store, student);
+    return TRUE;
+}
+
+guint student_store_size(StudentStore *store) {
+    g_return_val_if_fail(store != NULL, 0);
+    return g_hash_table_size(store->by_key);
+}
+
+// Collect students with min_gpa <= gpa <= max_gpa in O(log n + k)
+static GPtrArray* gpa_index_range(GTree *index, double min_gpa, double max_gpa) {
+    GPtrArray *result = g_ptr_array_new();
+    HashStudent probe = { NULL, G_MININT, min_gpa, NULL };
+    
+    GTreeNode *node = g_tree_lower_bound(index, &probe);
+    // Only a student with ID G_MININT can tie the probe; step back over it
+    for (GTreeNode *prev = node ? g_tree_node_previous(node) : NULL;
+         prev && ((HashStudent*)g_tree_node_key(prev))->gpa >= min_gpa;
+         prev = g_tree_node_previous(prev)) {
+        node = prev;
+    }
+    
+    for (; node != NULL; node = g_tree_node_next(node)) {
+        HashStudent *student = g_tree_node_key(node);
+        if (student->gpa > max_gpa) {
+            break;
+        }
+        g_ptr_array_add(result, student);
+    }
+    return result;
+}
+
+GPtrArray* student_store_find_by_major(StudentStore *store, const char *major) {
+    g_return_val_if_fail(major != NULL, NULL);
+    return student_store_find_by_major_min_gpa(store, major, -G_MAXDOUBLE);
+}
+
+GPtrArray* student_store_find_by_gpa_range(StudentStore *store, double min_gpa, double max_gpa) {
+    g_return_val_if_fail(store != NULL, NULL);
+    return gpa_index_range(store->by_gpa, min_gpa, max_gpa);
+}
+
+GPtrArray* student_store_find_by_major_min_gpa(StudentStore *store, const char *major, double min_gpa) {
+    g_return_val_if_fail(store != NULL, NULL);
+    g_return_val_if_fail(major != NULL, NULL);
+    
+    GTree *major_index = g_hash_table_lookup(store->by_major, major);
+    if (!major_index) {
+        return g_ptr_array_new();
+    }
+    return gpa_index_range(major_index, min_gpa, G_MAXDOUBLE);
+}
+
 // Helper function to collect high GPA students
 void collect_high_gpa_students(gpointer key, gpointer value, gpointer user_data) {
     HashStudent *student = (HashStudent*)value;
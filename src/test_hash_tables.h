@@ -2,6 +2,7 @@
 #define TEST_HASH_TABLES_H
 
 #include <glib.h>
+#include "record_arena.h"
 
 /**
  * Structure to represent student information for hash tables demo
@@ -23,6 +24,14 @@ void test_hash_tables(void);
  */
 HashStudent* hash_student_new(const char *name, int student_id, double gpa, const char *major);
 
+/**
+ * Create a new student whose struct and strings share one arena block.
+ * Tables holding arena students must not use hash_student_free() as their
+ * value destructor; the arena releases them as a batch.
+ */
+HashStudent* hash_student_new_in_arena(RecordArena *arena, const char *name, int student_id,
+                                       double gpa, const char *major);
+
 /**
  * Free student memory
  */
@@ -39,4 +48,41 @@ void hash_student_print(HashStudent *student);
 void hash_table_add_student(GHashTable *table, const char *key, HashStudent *student);
 void hash_table_print_all(GHashTable *table);
 
+/**
+ * Student store - the primary key -> student hash table plus secondary
+ * indexes that are kept in sync by student_store_add/student_store_remove:
+ * - by_major: major -> GTree of that major's students ordered by GPA
+ * - by_gpa:   GTree of every student ordered by GPA
+ *
+ * Indexed students must not have gpa or major modified directly; use
+ * student_store_update_gpa() so the ordered indexes stay consistent.
+ */
+typedef struct {
+    GHashTable *by_key;
+    GHashTable *by_major;
+    GTree *by_gpa;
+} StudentStore;
+
+StudentStore* student_store_new(void);
+void student_store_free(StudentStore *store);
+
+/**
+ * Add a student (the store takes ownership), replacing any student
+ * already stored under key. The student's major must be non-NULL.
+ * Adding a student again under its own key does nothing; use student_store_update_gpa() to change a stored one.
+ */
+void student_store_add(StudentStore *store, const char *key, HashStudent *student);
+gboolean student_store_remove(StudentStore *store, const char *key);
+HashStudent* student_store_lookup(StudentStore *store, const char *key);
+gboolean student_store_update_gpa(StudentStore *store, const char *key, double gpa);
+guint student_store_size(StudentStore *store);
+
+/**
+ * Indexed queries - results are GPtrArrays of HashStudent* owned by the
+ * store, ordered by GPA; free the array with g_ptr_array_free(array, TRUE)
+ */
+GPtrArray* student_store_find_by_major(StudentStore *store, const char *major);
+GPtrArray* student_store_find_by_gpa_range(StudentStore *store, double min_gpa, double max_gpa);
+GPtrArray* student_store_find_by_major_min_gpa(StudentStore *store, const char *major, double min_gpa);
+
 #endif /* TEST_HASH_TABLES_H */
\ No newline at end of file
@@ -1,6 +1,19 @@
+#define _GNU_SOURCE  /* sched_getcpu */
+#define _POSIX_C_SOURCE 200809L
+
 #include "test_signals_properties.h"
+#include "event_log.h"
+#include "record_arena.h"
+#include "timer_wheel.h"
+#include <math.h>
+#include <stdarg.h>
+#include <stdatomic.h>
 #include <stdio.h>
 #include <string.h>
+#include <time.h>
+#ifdef __linux__
+#include <sched.h>
+#endif
 
 /* =============================================================================
  * IComparable Interface Implementation
@@ -44,9 +57,19 @@ struct _BankAccount {
     GObject parent_instance;
     gchar *account_number;
     gchar *owner_name;
-    gdouble balance;
-    gdouble credit_limit;
-    gboolean is_frozen;
+    /* Balances are integer cents updated with atomic operations, so deposits
+     * and withdrawals never take the lock. The lock serializes transfers and
+     * batches with changes to is_frozen and credit_limit_cents. */
+    GMutex lock;
+    atomic_int_fast64_t balance_cents;
+    atomic_int_fast64_t credit_limit_cents;
+    gint is_frozen;             /* atomic; written with the lock held */
+    gint emit_timing;           /* atomic */
+    /* Emission counters; signals are emitted without the lock held */
+    atomic_uint_fast64_t emitted;
+    atomic_uint_fast64_t skipped;
+    atomic_uint_fast64_t emit_ns;
+    atomic_uint_fast64_t max_emit_ns;
 };
 
 /* Property enumeration */
@@ -55,6 +78,7 @@ enum {
     BANK_ACCOUNT_PROP_ACCOUNT_NUMBER,
     BANK_ACCOUNT_PROP_OWNER_NAME,
     BANK_ACCOUNT_PROP_BALANCE,
+    BANK_ACCOUNT_PROP_BALANCE_CENTS,
     BANK_ACCOUNT_PROP_CREDIT_LIMIT,
     BANK_ACCOUNT_PROP_IS_FROZEN,
     BANK_ACCOUNT_N_PROPERTIES
@@ -69,14 +93,109 @@ enum {
     BANK_ACCOUNT_SIGNAL_LOW_BALANCE,
     BANK_ACCOUNT_SIGNAL_ACCOUNT_FROZEN,
     BANK_ACCOUNT_SIGNAL_ACCOUNT_UNFROZEN,
+    BANK_ACCOUNT_SIGNAL_BATCH_APPLIED,
     BANK_ACCOUNT_N_SIGNALS
 };
 
+/* Balance below which "low-balance" is emitted after a withdrawal */
+#define BANK_ACCOUNT_LOW_BALANCE_CENTS (100 * BANK_ACCOUNT_CENTS_PER_UNIT)
+
+static inline gboolean bank_amount_is_valid(gdouble amount) {
+    return isfinite(amount) && fabs(amount) <= BANK_ACCOUNT_MAX_AMOUNT;
+}
+
+/* The gdouble API rounds amounts to the nearest cent; callers check
+ * bank_amount_is_valid() first */
+static inline gint64 bank_amount_to_cents(gdouble amount) {
+    return (gint64)(amount * BANK_ACCOUNT_CENTS_PER_UNIT + (amount < 0 ? -0.5 : 0.5));
+}
+
+static inline gdouble bank_cents_to_amount(gint64 cents) {
+    return (gdouble)cents / BANK_ACCOUNT_CENTS_PER_UNIT;
+}
+
 static GParamSpec *bank_account_properties[BANK_ACCOUNT_N_PROPERTIES] = { NULL, };
 static guint bank_account_signals[BANK_ACCOUNT_N_SIGNALS] = { 0, };
+static guint bank_account_notify_signal = 0;
 
 G_DEFINE_TYPE(BankAccount, bank_account, G_TYPE_OBJECT)
 
+/* Emission fast path: with no handler connected, g_signal_emit() would still
+ * collect its arguments into GValues and walk the emission machinery only to
+ * find nothing to call, so skip the emission entirely. BankAccount signals
+ * have no class handlers, and emission hooks are not supported. */
+static inline gboolean bank_account_has_listeners(BankAccount *self, guint signal_id, GQuark detail) {
+    if (g_signal_has_handler_pending(self, signal_id, detail, FALSE)) {
+        return TRUE;
+    }
+    atomic_fetch_add_explicit(&self->skipped, 1, memory_order_relaxed);
+    return FALSE;
+}
+
+static inline guint64 bank_account_emit_begin(BankAccount *self) {
+    if (!g_atomic_int_get(&self->emit_timing)) {
+        return 0;
+    }
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (guint64)ts.tv_sec * 1000000000ULL + (guint64)ts.tv_nsec;
+}
+
+static inline void bank_account_emit_end(BankAccount *self, guint64 start_ns) {
+    atomic_fetch_add_explicit(&self->emitted, 1, memory_order_relaxed);
+    if (start_ns != 0) {
+        guint64 elapsed = bank_account_emit_begin(self) - start_ns;
+        atomic_fetch_add_explicit(&self->emit_ns, elapsed, memory_order_relaxed);
+        guint64 max = atomic_load_explicit(&self->max_emit_ns, memory_order_relaxed);
+        while (elapsed > max &&
+               !atomic_compare_exchange_weak_explicit(&self->max_emit_ns, &max, elapsed,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+        }
+    }
+}
+
+/* g_signal_emit() for BankAccount signals, skipped when nothing is connected */
+static void bank_account_emit(BankAccount *self, guint signal_index, ...) {
+    guint signal_id = bank_account_signals[signal_index];
+    if (!bank_account_has_listeners(self, signal_id, 0)) {
+        return;
+    }
+    
+    va_list args;
+    va_start(args, signal_index);
+    guint64 start = bank_account_emit_begin(self);
+    g_signal_emit_valist(self, signal_id, 0, args);
+    bank_account_emit_end(self, start);
+    va_end(args);
+}
+
+/* Lock two distinct accounts in address order, so that transfers running in
+ * opposite directions between the same accounts cannot deadlock */
+static void bank_account_lock_pair(BankAccount *a, BankAccount *b) {
+    if ((guintptr)a > (guintptr)b) {
+        BankAccount *tmp = a;
+        a = b;
+        b = tmp;
+    }
+    g_mutex_lock(&a->lock);
+    g_mutex_lock(&b->lock);
+}
+
+static void bank_account_unlock_pair(BankAccount *a, BankAccount *b) {
+    g_mutex_unlock(&a->lock);
+    g_mutex_unlock(&b->lock);
+}
+
+/* g_object_notify_by_pspec(), skipped when nobody watches the property */
+static void bank_account_notify(BankAccount *self, guint property_id) {
+    GParamSpec *pspec = bank_account_properties[property_id];
+    if (bank_account_has_listeners(self, bank_account_notify_signal, g_param_spec_get_name_quark(pspec))) {
+        guint64 start = bank_account_emit_begin(self);
+        g_object_notify_by_pspec(G_OBJECT(self), pspec);
+        bank_account_emit_end(self, start);
+    }
+}
+
 static void bank_account_get_property(GObject *object, guint property_id,
                                      GValue *value, GParamSpec *pspec) {
     BankAccount *self = BANK_ACCOUNT(object);
@@ -89,13 +208,16 @@ static void bank_account_get_property(GObject *object, guint property_id,
             g_value_set_string(value, self->owner_name);
             break;
         case BANK_ACCOUNT_PROP_BALANCE:
-            g_value_set_double(value, self->balance);
+            g_value_set_double(value, bank_account_get_balance(self));
+            break;
+        case BANK_ACCOUNT_PROP_BALANCE_CENTS:
+            g_value_set_int64(value, bank_account_get_balance_cents(self));
             break;
         case BANK_ACCOUNT_PROP_CREDIT_LIMIT:
-            g_value_set_double(value, self->credit_limit);
+            g_value_set_double(value, bank_cents_to_amount(atomic_load(&self->credit_limit_cents)));
             break;
         case BANK_ACCOUNT_PROP_IS_FROZEN:
-            g_value_set_boolean(value, self->is_frozen);
+            g_value_set_boolean(value, bank_account_is_frozen(self));
             break;
         default:
             G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
@@ -117,13 +239,22 @@ static void bank_account_set_property(GObject *object, guint property_id,
             self->owner_name = g_value_dup_string(value);
             break;
         case BANK_ACCOUNT_PROP_BALANCE:
-            self->balance = g_value_get_double(value);
+            g_return_if_fail(bank_amount_is_valid(g_value_get_double(value)));
+            atomic_store(&self->balance_cents, bank_amount_to_cents(g_value_get_double(value)));
+            break;
+        case BANK_ACCOUNT_PROP_BALANCE_CENTS:
+            atomic_store(&self->balance_cents, g_value_get_int64(value));
             break;
         case BANK_ACCOUNT_PROP_CREDIT_LIMIT:
-            self->credit_limit = g_value_get_double(value);
+            g_return_if_fail(bank_amount_is_valid(g_value_get_double(value)));
+            g_mutex_lock(&self->lock);
+            atomic_store(&self->credit_limit_cents, bank_amount_to_cents(g_value_get_double(value)));
+            g_mutex_unlock(&self->lock);
             break;
         case BANK_ACCOUNT_PROP_IS_FROZEN:
-            self->is_frozen = g_value_get_boolean(value);
+            g_mutex_lock(&self->lock);
+            g_atomic_int_set(&self->is_frozen, g_value_get_boolean(value));
+            g_mutex_unlock(&self->lock);
             break;
         default:
             G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
@@ -138,6 +269,7 @@ static void bank_account_finalize(GObject *object) {
     
     g_free(self->account_number);
     g_free(self->owner_name);
+    g_mutex_clear(&self->lock);
     
     G_OBJECT_CLASS(bank_account_parent_class)->finalize(object);
 }
@@ -163,9 +295,14 @@ static void bank_account_class_init(BankAccountClass *klass) {
                            -G_MAXDOUBLE, G_MAXDOUBLE, 0.0, 
                            G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
     
+    bank_account_properties[BANK_ACCOUNT_PROP_BALANCE_CENTS] = 
+        g_param_spec_int64("balance-cents", "Balance in Cents", "Current account balance in cents",
+                          G_MININT64, G_MAXINT64, 0,
+                          G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
+    
     bank_account_properties[BANK_ACCOUNT_PROP_CREDIT_LIMIT] = 
         g_param_spec_double("credit-limit", "Credit Limit", "Account credit limit",
-                           0.0, G_MAXDOUBLE, 0.0, 
+                           0.0, BANK_ACCOUNT_MAX_AMOUNT, 0.0, 
                            G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS);
     
     bank_account_properties[BANK_ACCOUNT_PROP_IS_FROZEN] = 
@@ -197,6 +334,30 @@ static void bank_account_class_init(BankAccountClass *klass) {
                      G_TYPE_STRING,    /* description */
                      G_TYPE_DOUBLE);   /* new balance */
     
+    bank_account_signals[BANK_ACCOUNT_SIGNAL_TRANSFER_IN] = 
+        g_signal_new("transfer-in",
+                     G_TYPE_FROM_CLASS(klass),
+                     G_SIGNAL_RUN_FIRST,
+                     0, NULL, NULL,
+                     NULL,
+                     G_TYPE_NONE, 4,
+                     G_TYPE_FROM_CLASS(klass),  /* source account */
+                     G_TYPE_DOUBLE,             /* amount */
+                     G_TYPE_STRING,             /* description */
+                     G_TYPE_DOUBLE);            /* new balance */
+    
+    bank_account_signals[BANK_ACCOUNT_SIGNAL_TRANSFER_OUT] = 
+        g_signal_new("transfer-out",
+                     G_TYPE_FROM_CLASS(klass),
+                     G_SIGNAL_RUN_FIRST,
+                     0, NULL, NULL,
+                     NULL,
+                     G_TYPE_NONE, 4,
+                     G_TYPE_FROM_CLASS(klass),  /* destination account */
+                     G_TYPE_DOUBLE,             /* amount */
+                     G_TYPE_STRING,             /* description */
+                     G_TYPE_DOUBLE);            /* new balance */
+    
     bank_account_signals[BANK_ACCOUNT_SIGNAL_LOW_BALANCE] = 
         g_signal_new("low-balance",
                      G_TYPE_FROM_CLASS(klass),
@@ -221,104 +382,308 @@ static void bank_account_class_init(BankAccountClass *klass) {
                      0, NULL, NULL,
                      NULL,
                      G_TYPE_NONE, 0);
+    
+    bank_account_signals[BANK_ACCOUNT_SIGNAL_BATCH_APPLIED] = 
+        g_signal_new("batch-applied",
+                     G_TYPE_FROM_CLASS(klass),
+                     G_SIGNAL_RUN_FIRST,
+                     0, NULL, NULL,
+                     NULL,
+                     G_TYPE_NONE, 5,
+                     G_TYPE_UINT,      /* operations applied */
+                     G_TYPE_UINT,      /* operations rejected */
+                     G_TYPE_DOUBLE,    /* total deposited */
+                     G_TYPE_DOUBLE,    /* total withdrawn */
+                     G_TYPE_DOUBLE);   /* new balance */
+    
+    bank_account_notify_signal = g_signal_lookup("notify", G_TYPE_OBJECT);
 }
 
 static void bank_account_init(BankAccount *self) {
     self->account_number = NULL;
     self->owner_name = NULL;
-    self->balance = 0.0;
-    self->credit_limit = 0.0;
+    g_mutex_init(&self->lock);
+    atomic_init(&self->balance_cents, 0);
+    atomic_init(&self->credit_limit_cents, 0);
     self->is_frozen = FALSE;
+    self->emit_timing = FALSE;
+    atomic_init(&self->emitted, 0);
+    atomic_init(&self->skipped, 0);
+    atomic_init(&self->emit_ns, 0);
+    atomic_init(&self->max_emit_ns, 0);
     
     printf("[Object] BankAccount instance created\n");
 }
 
 BankAccount* bank_account_new(const gchar *account_number, const gchar *owner_name, gdouble initial_balance) {
+    g_return_val_if_fail(bank_amount_is_valid(initial_balance), NULL);
+    
     BankAccount *account = g_object_new(TYPE_BANK_ACCOUNT,
                                        "account-number", account_number,
                                        "owner-name", owner_name,
                                        NULL);
     
-    account->balance = initial_balance;
+    atomic_store(&account->balance_cents, bank_amount_to_cents(initial_balance));
     return account;
 }
 
-gboolean bank_account_deposit(BankAccount *self, gdouble amount, const gchar *description) {
+/* Add cents to the balance; returns the new balance */
+static inline gint64 bank_account_credit(BankAccount *self, gint64 cents) {
+    return atomic_fetch_add_explicit(&self->balance_cents, cents, memory_order_relaxed) + cents;
+}
+
+/* Take cents from the balance unless that would exceed the credit limit */
+static gboolean bank_account_debit(BankAccount *self, gint64 cents, gint64 *new_balance) {
+    gint64 limit = atomic_load_explicit(&self->credit_limit_cents, memory_order_relaxed);
+    gint64 balance = atomic_load_explicit(&self->balance_cents, memory_order_relaxed);
+    do {
+        if (balance + limit < cents) {
+            return FALSE;
+        }
+    } while (!atomic_compare_exchange_weak_explicit(&self->balance_cents, &balance, balance - cents,
+                                                    memory_order_relaxed, memory_order_relaxed));
+    *new_balance = balance - cents;
+    return TRUE;
+}
+
+/* Signals are emitted without any lock held and carry the balance that the
+ * operation produced */
+
+gboolean bank_account_deposit_cents(BankAccount *self, gint64 cents, const gchar *description) {
     g_return_val_if_fail(IS_BANK_ACCOUNT(self), FALSE);
-    g_return_val_if_fail(amount > 0, FALSE);
+    g_return_val_if_fail(cents > 0, FALSE);
     
-    if (self->is_frozen) {
+    if (g_atomic_int_get(&self->is_frozen)) {
         printf("Transaction denied: Account is frozen\n");
         return FALSE;
     }
     
-    self->balance += amount;
+    gint64 new_balance = bank_account_credit(self, cents);
     
     /* Emit deposit signal */
-    g_signal_emit(self, bank_account_signals[BANK_ACCOUNT_SIGNAL_DEPOSIT], 0,
-                  amount, description ? description : "Deposit", self->balance);
+    bank_account_emit(self, BANK_ACCOUNT_SIGNAL_DEPOSIT, bank_cents_to_amount(cents),
+                      description ? description : "Deposit", bank_cents_to_amount(new_balance));
     
-    /* Notify property change */
-    g_object_notify_by_pspec(G_OBJECT(self), bank_account_properties[BANK_ACCOUNT_PROP_BALANCE]);
+    /* Notify property changes */
+    bank_account_notify(self, BANK_ACCOUNT_PROP_BALANCE);
+    bank_account_notify(self, BANK_ACCOUNT_PROP_BALANCE_CENTS);
     
     return TRUE;
 }
 
-gboolean bank_account_withdraw(BankAccount *self, gdouble amount, const gchar *description) {
+gboolean bank_account_withdraw_cents(BankAccount *self, gint64 cents, const gchar *description) {
     g_return_val_if_fail(IS_BANK_ACCOUNT(self), FALSE);
-    g_return_val_if_fail(amount > 0, FALSE);
+    g_return_val_if_fail(cents > 0, FALSE);
     
-    if (self->is_frozen) {
+    if (g_atomic_int_get(&self->is_frozen)) {
         printf("Transaction denied: Account is frozen\n");
         return FALSE;
     }
     
     /* Check if withdrawal is allowed (balance + credit limit) */
-    if (self->balance + self->credit_limit < amount) {
+    gint64 new_balance;
+    if (!bank_account_debit(self, cents, &new_balance)) {
         printf("Transaction denied: Insufficient funds\n");
         return FALSE;
     }
     
-    self->balance -= amount;
-    
     /* Emit withdrawal signal */
-    g_signal_emit(self, bank_account_signals[BANK_ACCOUNT_SIGNAL_WITHDRAWAL], 0,
-                  amount, description ? description : "Withdrawal", self->balance);
+    bank_account_emit(self, BANK_ACCOUNT_SIGNAL_WITHDRAWAL, bank_cents_to_amount(cents),
+                      description ? description : "Withdrawal", bank_cents_to_amount(new_balance));
     
     /* Check for low balance */
-    if (self->balance < 100.0) {
-        g_signal_emit(self, bank_account_signals[BANK_ACCOUNT_SIGNAL_LOW_BALANCE], 0, self->balance);
+    if (new_balance < BANK_ACCOUNT_LOW_BALANCE_CENTS) {
+        bank_account_emit(self, BANK_ACCOUNT_SIGNAL_LOW_BALANCE, bank_cents_to_amount(new_balance));
+    }
+    
+    /* Notify property changes */
+    bank_account_notify(self, BANK_ACCOUNT_PROP_BALANCE);
+    bank_account_notify(self, BANK_ACCOUNT_PROP_BALANCE_CENTS);
+    
+    return TRUE;
+}
+
+gboolean bank_account_transfer_cents(BankAccount *from, BankAccount *to, gint64 cents, const gchar *description) {
+    g_return_val_if_fail(IS_BANK_ACCOUNT(from), FALSE);
+    g_return_val_if_fail(IS_BANK_ACCOUNT(to), FALSE);
+    g_return_val_if_fail(from != to, FALSE);
+    g_return_val_if_fail(cents > 0, FALSE);
+    
+    /* Holding both locks keeps the frozen flags and the credit limit fixed
+     * while the money moves. The debit is checked and applied atomically and
+     * the credit cannot fail, so money is never lost or created. */
+    bank_account_lock_pair(from, to);
+    if (g_atomic_int_get(&from->is_frozen) || g_atomic_int_get(&to->is_frozen)) {
+        bank_account_unlock_pair(from, to);
+        printf("Transaction denied: Account is frozen\n");
+        return FALSE;
+    }
+    
+    gint64 from_balance;
+    if (!bank_account_debit(from, cents, &from_balance)) {
+        bank_account_unlock_pair(from, to);
+        printf("Transaction denied: Insufficient funds\n");
+        return FALSE;
     }
+    gint64 to_balance = bank_account_credit(to, cents);
+    bank_account_unlock_pair(from, to);
     
-    /* Notify property change */
-    g_object_notify_by_pspec(G_OBJECT(self), bank_account_properties[BANK_ACCOUNT_PROP_BALANCE]);
+    if (!description) {
+        description = "Transfer";
+    }
+    gdouble amount = bank_cents_to_amount(cents);
+    bank_account_emit(from, BANK_ACCOUNT_SIGNAL_TRANSFER_OUT, to, amount, description,
+                      bank_cents_to_amount(from_balance));
+    bank_account_emit(to, BANK_ACCOUNT_SIGNAL_TRANSFER_IN, from, amount, description,
+                      bank_cents_to_amount(to_balance));
+    
+    if (from_balance < BANK_ACCOUNT_LOW_BALANCE_CENTS) {
+        bank_account_emit(from, BANK_ACCOUNT_SIGNAL_LOW_BALANCE, bank_cents_to_amount(from_balance));
+    }
+    
+    bank_account_notify(from, BANK_ACCOUNT_PROP_BALANCE);
+    bank_account_notify(from, BANK_ACCOUNT_PROP_BALANCE_CENTS);
+    bank_account_notify(to, BANK_ACCOUNT_PROP_BALANCE);
+    bank_account_notify(to, BANK_ACCOUNT_PROP_BALANCE_CENTS);
     
     return TRUE;
 }
 
+gboolean bank_account_deposit(BankAccount *self, gdouble amount, const gchar *description) {
+    g_return_val_if_fail(amount > 0 && bank_amount_is_valid(amount), FALSE);
+    return bank_account_deposit_cents(self, bank_amount_to_cents(amount), description);
+}
+
+gboolean bank_account_withdraw(BankAccount *self, gdouble amount, const gchar *description) {
+    g_return_val_if_fail(amount > 0 && bank_amount_is_valid(amount), FALSE);
+    return bank_account_withdraw_cents(self, bank_amount_to_cents(amount), description);
+}
+
+gboolean bank_account_transfer(BankAccount *from, BankAccount *to, gdouble amount, const gchar *description) {
+    g_return_val_if_fail(amount > 0 && bank_amount_is_valid(amount), FALSE);
+    return bank_account_transfer_cents(from, to, bank_amount_to_cents(amount), description);
+}
+
+guint bank_account_apply_batch(BankAccount *self, const BankAccountOp *ops, gsize n_ops) {
+    g_return_val_if_fail(IS_BANK_ACCOUNT(self), 0);
+    g_return_val_if_fail(ops != NULL || n_ops == 0, 0);
+    
+    guint applied = 0;
+    guint rejected = 0;
+    guint withdrawals = 0;
+    gint64 deposited = 0;
+    gint64 withdrawn = 0;
+    gint64 new_balance = 0;
+    
+    /* The lock keeps the account from being frozen halfway through */
+    g_mutex_lock(&self->lock);
+    if (g_atomic_int_get(&self->is_frozen)) {
+        g_mutex_unlock(&self->lock);
+        printf("Transaction denied: Account is frozen\n");
+        return 0;
+    }
+    
+    for (gsize i = 0; i < n_ops; i++) {
+        gint64 cents = ops[i].amount > 0 && bank_amount_is_valid(ops[i].amount)
+            ? bank_amount_to_cents(ops[i].amount) : 0;
+        if (cents <= 0) {
+            rejected++;
+            continue;
+        }
+        
+        if (ops[i].kind == BANK_ACCOUNT_OP_DEPOSIT) {
+            new_balance = bank_account_credit(self, cents);
+            deposited += cents;
+        } else if (ops[i].kind == BANK_ACCOUNT_OP_WITHDRAW &&
+                   bank_account_debit(self, cents, &new_balance)) {
+            withdrawn += cents;
+            withdrawals++;
+        } else {
+            rejected++;
+            continue;
+        }
+        applied++;
+    }
+    g_mutex_unlock(&self->lock);
+    
+    if (applied == 0) {
+        new_balance = bank_account_get_balance_cents(self);
+    }
+    
+    /* Property notifications are queued and merged until the thaw */
+    g_object_freeze_notify(G_OBJECT(self));
+    
+    if (applied > 0) {
+        bank_account_notify(self, BANK_ACCOUNT_PROP_BALANCE);
+        bank_account_notify(self, BANK_ACCOUNT_PROP_BALANCE_CENTS);
+    }
+    
+    /* One summary signal instead of one signal per operation */
+    bank_account_emit(self, BANK_ACCOUNT_SIGNAL_BATCH_APPLIED, applied, rejected,
+                      bank_cents_to_amount(deposited), bank_cents_to_amount(withdrawn),
+                      bank_cents_to_amount(new_balance));
+    
+    /* Low balance is judged on the final balance only */
+    if (withdrawals > 0 && new_balance < BANK_ACCOUNT_LOW_BALANCE_CENTS) {
+        bank_account_emit(self, BANK_ACCOUNT_SIGNAL_LOW_BALANCE, bank_cents_to_amount(new_balance));
+    }
+    
+    g_object_thaw_notify(G_OBJECT(self));
+    
+    return applied;
+}
+
 void bank_account_freeze(BankAccount *self) {
     g_return_if_fail(IS_BANK_ACCOUNT(self));
     
-    if (!self->is_frozen) {
-        self->is_frozen = TRUE;
-        g_signal_emit(self, bank_account_signals[BANK_ACCOUNT_SIGNAL_ACCOUNT_FROZEN], 0);
-        g_object_notify_by_pspec(G_OBJECT(self), bank_account_properties[BANK_ACCOUNT_PROP_IS_FROZEN]);
+    g_mutex_lock(&self->lock);
+    gboolean changed = !g_atomic_int_get(&self->is_frozen);
+    g_atomic_int_set(&self->is_frozen, TRUE);
+    g_mutex_unlock(&self->lock);
+    
+    if (changed) {
+        bank_account_emit(self, BANK_ACCOUNT_SIGNAL_ACCOUNT_FROZEN);
+        bank_account_notify(self, BANK_ACCOUNT_PROP_IS_FROZEN);
     }
 }
 
 void bank_account_unfreeze(BankAccount *self) {
     g_return_if_fail(IS_BANK_ACCOUNT(self));
     
-    if (self->is_frozen) {
-        self->is_frozen = FALSE;
-        g_signal_emit(self, bank_account_signals[BANK_ACCOUNT_SIGNAL_ACCOUNT_UNFROZEN], 0);
-        g_object_notify_by_pspec(G_OBJECT(self), bank_account_properties[BANK_ACCOUNT_PROP_IS_FROZEN]);
+    g_mutex_lock(&self->lock);
+    gboolean changed = g_atomic_int_get(&self->is_frozen);
+    g_atomic_int_set(&self->is_frozen, FALSE);
+    g_mutex_unlock(&self->lock);
+    
+    if (changed) {
+        bank_account_emit(self, BANK_ACCOUNT_SIGNAL_ACCOUNT_UNFROZEN);
+        bank_account_notify(self, BANK_ACCOUNT_PROP_IS_FROZEN);
+    }
+}
+
+void bank_account_set_credit_limit(BankAccount *self, gdouble limit) {
+    g_return_if_fail(IS_BANK_ACCOUNT(self));
+    g_return_if_fail(limit >= 0.0 && bank_amount_is_valid(limit));
+    
+    gint64 limit_cents = bank_amount_to_cents(limit);
+    g_mutex_lock(&self->lock);
+    gboolean changed = atomic_load(&self->credit_limit_cents) != limit_cents;
+    atomic_store(&self->credit_limit_cents, limit_cents);
+    g_mutex_unlock(&self->lock);
+    
+    if (changed) {
+        bank_account_notify(self, BANK_ACCOUNT_PROP_CREDIT_LIMIT);
     }
 }
 
+gint64 bank_account_get_balance_cents(BankAccount *self) {
+    g_return_val_if_fail(IS_BANK_ACCOUNT(self), 0);
+    return atomic_load_explicit(&self->balance_cents, memory_order_relaxed);
+}
+
 gdouble bank_account_get_balance(BankAccount *self) {
     g_return_val_if_fail(IS_BANK_ACCOUNT(self), 0.0);
-    return self->balance;
+    return bank_cents_to_amount(atomic_load_explicit(&self->balance_cents, memory_order_relaxed));
 }
 
 const gchar* bank_account_get_account_number(BankAccount *self) {
@@ -328,7 +693,31 @@ const gchar* bank_account_get_account_number(BankAccount *self) {
 
 gboolean bank_account_is_frozen(BankAccount *self) {
     g_return_val_if_fail(IS_BANK_ACCOUNT(self), FALSE);
-    return self->is_frozen;
+    return g_atomic_int_get(&self->is_frozen);
+}
+
+void bank_account_set_emit_timing(BankAccount *self, gboolean enabled) {
+    g_return_if_fail(IS_BANK_ACCOUNT(self));
+    g_atomic_int_set(&self->emit_timing, enabled ? TRUE : FALSE);
+}
+
+void bank_account_get_emit_stats(BankAccount *self, BankAccountEmitStats *stats) {
+    g_return_if_fail(IS_BANK_ACCOUNT(self));
+    g_return_if_fail(stats != NULL);
+    
+    stats->emitted = atomic_load_explicit(&self->emitted, memory_order_relaxed);
+    stats->skipped = atomic_load_explicit(&self->skipped, memory_order_relaxed);
+    stats->emit_ns = atomic_load_explicit(&self->emit_ns, memory_order_relaxed);
+    stats->max_emit_ns = atomic_load_explicit(&self->max_emit_ns, memory_order_relaxed);
+}
+
+void bank_account_reset_emit_stats(BankAccount *self) {
+    g_return_if_fail(IS_BANK_ACCOUNT(self));
+    
+    atomic_store_explicit(&self->emitted, 0, memory_order_relaxed);
+    atomic_store_explicit(&self->skipped, 0, memory_order_relaxed);
+    atomic_store_explicit(&self->emit_ns, 0, memory_order_relaxed);
+    atomic_store_explicit(&self->max_emit_ns, 0, memory_order_relaxed);
 }
 
 /* =============================================================================
@@ -342,6 +731,15 @@ struct _Counter {
     gint maximum;
     gint step;
     gchar *name;
+    
+    /* Coalesced notification */
+    guint update_depth;         /* nesting of counter_begin_update() */
+    gboolean pending;           /* changed since the last "value-changed" */
+    gint pending_old;           /* value before the first pending change */
+    gboolean merged;            /* several changes are pending */
+    guint notify_interval_ms;
+    gint64 last_emit_us;        /* monotonic time of the last rate-limited emission */
+    GSource *flush_source;      /* delivers the rest of a rate-limited burst */
 };
 
 enum {
@@ -351,6 +749,7 @@ enum {
     COUNTER_PROP_MAXIMUM,
     COUNTER_PROP_STEP,
     COUNTER_PROP_NAME,
+    COUNTER_PROP_NOTIFY_INTERVAL,
     COUNTER_N_PROPERTIES
 };
 
@@ -386,6 +785,9 @@ static void counter_get_property(GObject *object, guint property_id,
         case COUNTER_PROP_NAME:
             g_value_set_string(value, self->name);
             break;
+        case COUNTER_PROP_NOTIFY_INTERVAL:
+            g_value_set_uint(value, self->notify_interval_ms);
+            break;
         default:
             G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
             break;
@@ -413,6 +815,9 @@ static void counter_set_property(GObject *object, guint property_id,
             g_free(self->name);
             self->name = g_value_dup_string(value);
             break;
+        case COUNTER_PROP_NOTIFY_INTERVAL:
+            counter_set_notify_interval(self, g_value_get_uint(value));
+            break;
         default:
             G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
             break;
@@ -421,6 +826,10 @@ static void counter_set_property(GObject *object, guint property_id,
 
 static void counter_finalize(GObject *object) {
     Counter *self = COUNTER(object);
+    if (self->flush_source) {
+        g_source_destroy(self->flush_source);
+        g_source_unref(self->flush_source);
+    }
     g_free(self->name);
     G_OBJECT_CLASS(counter_parent_class)->finalize(object);
 }
@@ -436,12 +845,34 @@ static void counter_class_init(CounterClass *klass) {
     counter_properties[COUNTER_PROP_VALUE] = 
         g_param_spec_int("value", "Value", "Current counter value",
                         G_MININT, G_MAXINT, 0, 
-                        G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS);
+                        G_PARAM_READWRITE | G_PARAM_EXPLICIT_NOTIFY | G_PARAM_STATIC_STRINGS);
+    
+    /* Limits are construct properties so that they apply before "value" is set */
+    counter_properties[COUNTER_PROP_MINIMUM] = 
+        g_param_spec_int("minimum", "Minimum", "Lowest allowed value",
+                        G_MININT, G_MAXINT, G_MININT,
+                        G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_STRINGS);
+    
+    counter_properties[COUNTER_PROP_MAXIMUM] = 
+        g_param_spec_int("maximum", "Maximum", "Highest allowed value",
+                        G_MININT, G_MAXINT, G_MAXINT,
+                        G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_STRINGS);
+    
+    counter_properties[COUNTER_PROP_STEP] = 
+        g_param_spec_int("step", "Step", "Amount added by increment and removed by decrement",
+                        1, G_MAXINT, 1,
+                        G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_STRINGS);
     
     counter_properties[COUNTER_PROP_NAME] = 
         g_param_spec_string("name", "Name", "Counter name",
                            NULL, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS);
     
+    counter_properties[COUNTER_PROP_NOTIFY_INTERVAL] = 
+        g_param_spec_uint("notify-interval", "Notify interval",
+                         "Minimum milliseconds between value-changed emissions (0 = every change)",
+                         0, G_MAXUINT, 0,
+                         G_PARAM_READWRITE | G_PARAM_EXPLICIT_NOTIFY | G_PARAM_STATIC_STRINGS);
+    
     g_object_class_install_properties(object_class, COUNTER_N_PROPERTIES, counter_properties);
     
     /* Signals */
@@ -464,6 +895,14 @@ static void counter_class_init(CounterClass *klass) {
                      G_TYPE_NONE, 2,
                      G_TYPE_INT,        /* limit value */
                      G_TYPE_BOOLEAN);   /* is maximum? */
+    
+    counter_signals[COUNTER_SIGNAL_RESET] = 
+        g_signal_new("reset",
+                     G_TYPE_FROM_CLASS(klass),
+                     G_SIGNAL_RUN_FIRST,
+                     0, NULL, NULL,
+                     NULL,
+                     G_TYPE_NONE, 0);
 }
 
 static void counter_init(Counter *self) {
@@ -472,6 +911,12 @@ static void counter_init(Counter *self) {
     self->maximum = G_MAXINT;
     self->step = 1;
     self->name = NULL;
+    self->update_depth = 0;
+    self->pending = FALSE;
+    self->merged = FALSE;
+    self->notify_interval_ms = 0;
+    self->last_emit_us = 0;
+    self->flush_source = NULL;
 }
 
 Counter* counter_new(const gchar *name, gint initial_value, gint min, gint max, gint step) {
@@ -484,6 +929,84 @@ Counter* counter_new(const gchar *name, gint initial_value, gint min, gint max,
                        NULL);
 }
 
+void counter_flush(Counter *self) {
+    g_return_if_fail(IS_COUNTER(self));
+    
+    if (self->flush_source) {
+        g_source_destroy(self->flush_source);
+        g_clear_pointer(&self->flush_source, g_source_unref);
+    }
+    if (!self->pending) {
+        return;
+    }
+    
+    self->pending = FALSE;
+    if (self->merged && self->pending_old == self->value) {
+        return;     /* a burst that cancelled out; single sets are always announced */
+    }
+    if (self->notify_interval_ms > 0) {
+        self->last_emit_us = g_get_monotonic_time();
+    }
+    g_signal_emit(self, counter_signals[COUNTER_SIGNAL_VALUE_CHANGED], 0, self->pending_old, self->value);
+    g_object_notify_by_pspec(G_OBJECT(self), counter_properties[COUNTER_PROP_VALUE]);
+}
+
+static gboolean counter_flush_timeout(gpointer user_data) {
+    Counter *self = COUNTER(user_data);
+    g_clear_pointer(&self->flush_source, g_source_unref);
+    counter_flush(self);
+    return G_SOURCE_REMOVE;
+}
+
+// Announce the pending change now, or later if rate-limited
+static void counter_deliver(Counter *self) {
+    if (self->notify_interval_ms > 0) {
+        gint64 due_us = self->last_emit_us + (gint64)self->notify_interval_ms * 1000;
+        gint64 now_us = g_get_monotonic_time();
+        if (now_us < due_us) {
+            if (!self->flush_source) {
+                self->flush_source = g_timeout_source_new((guint)((due_us - now_us + 999) / 1000));
+                g_source_set_callback(self->flush_source, counter_flush_timeout, self, NULL);
+                g_source_attach(self->flush_source, g_main_context_get_thread_default());
+            }
+            return;
+        }
+    }
+    counter_flush(self);
+}
+
+void counter_begin_update(Counter *self) {
+    g_return_if_fail(IS_COUNTER(self));
+    self->update_depth++;
+}
+
+void counter_end_update(Counter *self) {
+    g_return_if_fail(IS_COUNTER(self));
+    g_return_if_fail(self->update_depth > 0);
+    
+    if (--self->update_depth == 0 && self->pending) {
+        counter_deliver(self);
+    }
+}
+
+void counter_set_notify_interval(Counter *self, guint interval_ms) {
+    g_return_if_fail(IS_COUNTER(self));
+    
+    if (self->notify_interval_ms == interval_ms) {
+        return;
+    }
+    self->notify_interval_ms = interval_ms;
+    if (interval_ms == 0 && self->update_depth == 0) {
+        counter_flush(self);
+    }
+    g_object_notify_by_pspec(G_OBJECT(self), counter_properties[COUNTER_PROP_NOTIFY_INTERVAL]);
+}
+
+guint counter_get_notify_interval(Counter *self) {
+    g_return_val_if_fail(IS_COUNTER(self), 0);
+    return self->notify_interval_ms;
+}
+
 gboolean counter_set_value(Counter *self, gint value) {
     g_return_val_if_fail(IS_COUNTER(self), FALSE);
     
@@ -491,10 +1014,18 @@ gboolean counter_set_value(Counter *self, gint value) {
         return FALSE;
     }
     
-    gint old_value = self->value;
+    if (!self->pending) {
+        self->pending = TRUE;
+        self->pending_old = self->value;
+        self->merged = FALSE;
+    } else {
+        self->merged = TRUE;
+    }
     self->value = value;
     
-    g_signal_emit(self, counter_signals[COUNTER_SIGNAL_VALUE_CHANGED], 0, old_value, value);
+    if (self->update_depth == 0) {
+        counter_deliver(self);
+    }
     
     return TRUE;
 }
@@ -502,7 +1033,7 @@ gboolean counter_set_value(Counter *self, gint value) {
 gboolean counter_increment(Counter *self) {
     g_return_val_if_fail(IS_COUNTER(self), FALSE);
     
-    if (self->value + self->step > self->maximum) {
+    if ((gint64)self->value + self->step > self->maximum) {
         g_signal_emit(self, counter_signals[COUNTER_SIGNAL_LIMIT_REACHED], 0, self->maximum, TRUE);
         return FALSE;
     }
@@ -513,7 +1044,7 @@ gboolean counter_increment(Counter *self) {
 gboolean counter_decrement(Counter *self) {
     g_return_val_if_fail(IS_COUNTER(self), FALSE);
     
-    if (self->value - self->step < self->minimum) {
+    if ((gint64)self->value - self->step < self->minimum) {
         g_signal_emit(self, counter_signals[COUNTER_SIGNAL_LIMIT_REACHED], 0, self->minimum, FALSE);
         return FALSE;
     }
@@ -538,108 +1069,1793 @@ const gchar* counter_get_name(Counter *self) {
 }
 
 /* =============================================================================
- * Event Logger Implementation
+ * AtomicCounter Class Implementation - Lock-Free Shared Counter
  * ============================================================================= */
 
-struct _EventLogger {
+#define ATOMIC_COUNTER_CACHE_LINE 64
+
+/* Events collected for the next dispatch on the counter's main context */
+#define ATOMIC_COUNTER_HIT_MAXIMUM 0x1
+#define ATOMIC_COUNTER_HIT_MINIMUM 0x2
+#define ATOMIC_COUNTER_WAS_RESET   0x4
+
+typedef struct {
+    atomic_int_fast64_t value;
+    char pad[ATOMIC_COUNTER_CACHE_LINE - sizeof(atomic_int_fast64_t)];
+} AtomicCounterShard;
+
+struct _AtomicCounter {
     GObject parent_instance;
-    gchar *log_name;
-    FILE *log_file;
+    gchar *name;
+    gint64 minimum;
+    gint64 maximum;
+    gint64 step;
+    gboolean sharded;
+    GMainContext *context;              /* signals are emitted where this runs */
+    GSource *dispatch_source;
+    gint64 last_emitted;                /* only used on the context's thread */
+    
+    AtomicCounterShard *shards;         /* sharded counters; cache-line aligned */
+    gpointer shards_memory;
+    guint shard_mask;
+    
+    char pad0[ATOMIC_COUNTER_CACHE_LINE];
+    atomic_int_fast64_t value;          /* bounded counters */
+    char pad1[ATOMIC_COUNTER_CACHE_LINE - sizeof(atomic_int_fast64_t)];
+    atomic_int dispatch_pending;
+    atomic_uint events;
 };
 
-G_DEFINE_TYPE(EventLogger, event_logger, G_TYPE_OBJECT)
+enum {
+    ATOMIC_COUNTER_PROP_0,
+    ATOMIC_COUNTER_PROP_VALUE,
+    ATOMIC_COUNTER_PROP_MINIMUM,
+    ATOMIC_COUNTER_PROP_MAXIMUM,
+    ATOMIC_COUNTER_PROP_STEP,
+    ATOMIC_COUNTER_PROP_NAME,
+    ATOMIC_COUNTER_PROP_SHARDED,
+    ATOMIC_COUNTER_PROP_CONTEXT,
+    ATOMIC_COUNTER_N_PROPERTIES
+};
 
-static void event_logger_finalize(GObject *object) {
-    EventLogger *self = EVENT_LOGGER(object);
-    
-    g_free(self->log_name);
-    if (self->log_file && self->log_file != stdout) {
-        fclose(self->log_file);
-    }
-    
-    G_OBJECT_CLASS(event_logger_parent_class)->finalize(object);
-}
+enum {
+    ATOMIC_COUNTER_SIGNAL_VALUE_CHANGED,
+    ATOMIC_COUNTER_SIGNAL_LIMIT_REACHED,
+    ATOMIC_COUNTER_SIGNAL_RESET,
+    ATOMIC_COUNTER_N_SIGNALS
+};
 
-static void event_logger_class_init(EventLoggerClass *klass) {
-    GObjectClass *object_class = G_OBJECT_CLASS(klass);
-    object_class->finalize = event_logger_finalize;
-}
+static GParamSpec *atomic_counter_properties[ATOMIC_COUNTER_N_PROPERTIES] = { NULL, };
+static guint atomic_counter_signals[ATOMIC_COUNTER_N_SIGNALS] = { 0, };
 
-static void event_logger_init(EventLogger *self) {
-    self->log_name = NULL;
-    self->log_file = stdout;  /* Default to stdout */
-}
+/* Shard slot of threads that cannot ask for their CPU, plus one */
+static GPrivate atomic_counter_thread_slot = G_PRIVATE_INIT(NULL);
+static atomic_uint atomic_counter_next_slot;
 
-EventLogger* event_logger_new(const gchar *log_name) {
-    EventLogger *logger = g_object_new(TYPE_EVENT_LOGGER, NULL);
-    logger->log_name = g_strdup(log_name);
-    return logger;
-}
+G_DEFINE_TYPE(AtomicCounter, atomic_counter, G_TYPE_OBJECT)
 
-/* Signal handlers for bank account */
-static void on_bank_deposit(BankAccount *account, gdouble amount, const gchar *description, 
-                           gdouble new_balance, EventLogger *logger) {
-    fprintf(logger->log_file, "[%s] DEPOSIT: $%.2f - %s (New Balance: $%.2f) [Account: %s]\n",
-            logger->log_name, amount, description, new_balance, 
-            bank_account_get_account_number(account));
+static inline guint atomic_counter_shard_index(const AtomicCounter *self) {
+#ifdef __linux__
+    int cpu = sched_getcpu();
+    if (G_LIKELY(cpu >= 0)) {
+        return (guint)cpu & self->shard_mask;
+    }
+#endif
+    guint slot = GPOINTER_TO_UINT(g_private_get(&atomic_counter_thread_slot));
+    if (slot == 0) {
+        slot = atomic_fetch_add(&atomic_counter_next_slot, 1) + 1;
+        g_private_set(&atomic_counter_thread_slot, GUINT_TO_POINTER(slot));
+    }
+    return (slot - 1) & self->shard_mask;
 }
 
-static void on_bank_withdrawal(BankAccount *account, gdouble amount, const gchar *description,
-                              gdouble new_balance, EventLogger *logger) {
-    fprintf(logger->log_file, "[%s] WITHDRAWAL: $%.2f - %s (New Balance: $%.2f) [Account: %s]\n",
-            logger->log_name, amount, description, new_balance,
-            bank_account_get_account_number(account));
+/* Wake the dispatch source unless a dispatch is already due. The load and
+ * the dispatcher's clear are both sequentially consistent, so either the
+ * updater sees the clear and wakes the source again, or the dispatcher
+ * sees the update. */
+static inline void atomic_counter_schedule_dispatch(AtomicCounter *self) {
+    if (!atomic_load(&self->dispatch_pending) && !atomic_exchange(&self->dispatch_pending, TRUE)) {
+        g_source_set_ready_time(self->dispatch_source, 0);
+    }
 }
 
-static void on_low_balance(BankAccount *account, gdouble balance, EventLogger *logger) {
-    fprintf(logger->log_file, "[%s] WARNING: Low balance $%.2f [Account: %s]\n",
-            logger->log_name, balance, bank_account_get_account_number(account));
+static void atomic_counter_add_event(AtomicCounter *self, guint event) {
+    if (!(atomic_load_explicit(&self->events, memory_order_relaxed) & event)) {
+        atomic_fetch_or(&self->events, event);
+    }
+    atomic_counter_schedule_dispatch(self);
 }
 
-void event_logger_connect_to_bank_account(EventLogger *self, BankAccount *account) {
-    g_signal_connect(account, "deposit", G_CALLBACK(on_bank_deposit), self);
-    g_signal_connect(account, "withdrawal", G_CALLBACK(on_bank_withdrawal), self);
-    g_signal_connect(account, "low-balance", G_CALLBACK(on_low_balance), self);
+/* Runs on the counter's main context. The source only holds a weak
+ * reference: the last unref may happen on a worker thread at any time, so
+ * the dispatch keeps the counter alive while it runs. */
+static gboolean atomic_counter_dispatch(gpointer user_data) {
+    AtomicCounter *self = g_weak_ref_get((GWeakRef*)user_data);
+    if (!self) {
+        return G_SOURCE_REMOVE;
+    }
+    
+    atomic_store(&self->dispatch_pending, FALSE);
+    guint events = atomic_exchange(&self->events, 0);
+    gint64 value = atomic_counter_get_value(self);
+    
+    if (value != self->last_emitted) {
+        gint64 old_value = self->last_emitted;
+        self->last_emitted = value;
+        g_signal_emit(self, atomic_counter_signals[ATOMIC_COUNTER_SIGNAL_VALUE_CHANGED], 0, old_value, value);
+        g_object_notify_by_pspec(G_OBJECT(self), atomic_counter_properties[ATOMIC_COUNTER_PROP_VALUE]);
+    }
+    if (events & ATOMIC_COUNTER_HIT_MAXIMUM) {
+        g_signal_emit(self, atomic_counter_signals[ATOMIC_COUNTER_SIGNAL_LIMIT_REACHED], 0, self->maximum, TRUE);
+    }
+    if (events & ATOMIC_COUNTER_HIT_MINIMUM) {
+        g_signal_emit(self, atomic_counter_signals[ATOMIC_COUNTER_SIGNAL_LIMIT_REACHED], 0, self->minimum, FALSE);
+    }
+    if (events & ATOMIC_COUNTER_WAS_RESET) {
+        g_signal_emit(self, atomic_counter_signals[ATOMIC_COUNTER_SIGNAL_RESET], 0);
+    }
+    
+    g_object_unref(self);
+    return G_SOURCE_CONTINUE;
 }
 
-/* Signal handlers for counter */
-static void on_counter_value_changed(Counter *counter, gint old_value, gint new_value, EventLogger *logger) {
-    fprintf(logger->log_file, "[%s] COUNTER '%s': %d -> %d\n",
-            logger->log_name, counter_get_name(counter), old_value, new_value);
+static void atomic_counter_weak_ref_free(gpointer data) {
+    GWeakRef *ref = (GWeakRef*)data;
+    g_weak_ref_clear(ref);
+    g_free(ref);
 }
 
-void event_logger_connect_to_counter(EventLogger *self, Counter *counter) {
-    g_signal_connect(counter, "value-changed", G_CALLBACK(on_counter_value_changed), self);
+// Ready-time only source: woken by g_source_set_ready_time(source, 0)
+static gboolean atomic_counter_source_dispatch(GSource *source, GSourceFunc callback, gpointer user_data) {
+    g_source_set_ready_time(source, -1);
+    return callback(user_data);
 }
 
-/* =============================================================================
- * Educational Demonstration Functions
- * ============================================================================= */
+static GSourceFuncs atomic_counter_source_funcs = {
+    NULL, NULL, atomic_counter_source_dispatch, NULL, NULL, NULL
+};
 
-void demonstrate_signal_system(void) {
-    printf("\n=== Signal System Demonstration ===\n");
-    printf("Demonstrating Observer pattern with GObject signals\n\n");
-    
-    /* Create bank account and logger */
-    BankAccount *account = bank_account_new("12345-67890", "Alice Johnson", 1000.0);
-    EventLogger *logger = event_logger_new("BankLogger");
-    
-    /* Connect signals */
-    event_logger_connect_to_bank_account(logger, account);
-    
-    printf("Initial balance: $%.2f\n", bank_account_get_balance(account));
+static void atomic_counter_get_property(GObject *object, guint property_id,
+                                        GValue *value, GParamSpec *pspec) {
+    AtomicCounter *self = ATOMIC_COUNTER(object);
     
-    /* Perform transactions - signals will be emitted */
-    printf("\nPerforming transactions:\n");
-    bank_account_deposit(account, 250.0, "Salary deposit");
-    bank_account_withdraw(account, 75.0, "ATM withdrawal");
-    bank_account_withdraw(account, 1100.0, "Large purchase");  /* Should trigger low balance */
-    
-    /* Cleanup */
-    g_object_unref(account);
+    switch (property_id) {
+        case ATOMIC_COUNTER_PROP_VALUE:
+            g_value_set_int64(value, atomic_counter_get_value(self));
+            break;
+        case ATOMIC_COUNTER_PROP_MINIMUM:
+            g_value_set_int64(value, self->minimum);
+            break;
+        case ATOMIC_COUNTER_PROP_MAXIMUM:
+            g_value_set_int64(value, self->maximum);
+            break;
+        case ATOMIC_COUNTER_PROP_STEP:
+            g_value_set_int64(value, self->step);
+            break;
+        case ATOMIC_COUNTER_PROP_NAME:
+            g_value_set_string(value, self->name);
+            break;
+        case ATOMIC_COUNTER_PROP_SHARDED:
+            g_value_set_boolean(value, self->sharded);
+            break;
+        case ATOMIC_COUNTER_PROP_CONTEXT:
+            g_value_set_boxed(value, self->context);
+            break;
+        default:
+            G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
+            break;
+    }
+}
+
+static void atomic_counter_set_property(GObject *object, guint property_id,
+                                        const GValue *value, GParamSpec *pspec) {
+    AtomicCounter *self = ATOMIC_COUNTER(object);
+    
+    switch (property_id) {
+        case ATOMIC_COUNTER_PROP_MINIMUM:
+            self->minimum = g_value_get_int64(value);
+            break;
+        case ATOMIC_COUNTER_PROP_MAXIMUM:
+            self->maximum = g_value_get_int64(value);
+            break;
+        case ATOMIC_COUNTER_PROP_STEP:
+            self->step = g_value_get_int64(value);
+            break;
+        case ATOMIC_COUNTER_PROP_NAME:
+            g_free(self->name);
+            self->name = g_value_dup_string(value);
+            break;
+        case ATOMIC_COUNTER_PROP_SHARDED:
+            self->sharded = g_value_get_boolean(value);
+            break;
+        case ATOMIC_COUNTER_PROP_CONTEXT:
+            self->context = g_value_dup_boxed(value);
+            break;
+        default:
+            G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
+            break;
+    }
+}
+
+static void atomic_counter_constructed(GObject *object) {
+    AtomicCounter *self = ATOMIC_COUNTER(object);
+    
+    G_OBJECT_CLASS(atomic_counter_parent_class)->constructed(object);
+    
+    if (self->sharded) {
+        guint n_shards = 1;
+        while (n_shards < g_get_num_processors()) {
+            n_shards <<= 1;
+        }
+        self->shards_memory = g_malloc0((n_shards + 1) * sizeof(AtomicCounterShard));
+        self->shards = (AtomicCounterShard*)(((guintptr)self->shards_memory + ATOMIC_COUNTER_CACHE_LINE - 1) &
+                                             ~(guintptr)(ATOMIC_COUNTER_CACHE_LINE - 1));
+        self->shard_mask = n_shards - 1;
+    }
+    
+    if (!self->context) {
+        self->context = g_main_context_ref_thread_default();
+    }
+    GWeakRef *ref = g_new(GWeakRef, 1);
+    g_weak_ref_init(ref, self);
+    self->dispatch_source = g_source_new(&atomic_counter_source_funcs, sizeof(GSource));
+    g_source_set_callback(self->dispatch_source, atomic_counter_dispatch, ref, atomic_counter_weak_ref_free);
+    g_source_attach(self->dispatch_source, self->context);
+}
+
+static void atomic_counter_dispose(GObject *object) {
+    AtomicCounter *self = ATOMIC_COUNTER(object);
+    
+    if (self->dispatch_source) {
+        g_source_destroy(self->dispatch_source);
+        g_clear_pointer(&self->dispatch_source, g_source_unref);
+    }
+    g_clear_pointer(&self->context, g_main_context_unref);
+    
+    G_OBJECT_CLASS(atomic_counter_parent_class)->dispose(object);
+}
+
+static void atomic_counter_finalize(GObject *object) {
+    AtomicCounter *self = ATOMIC_COUNTER(object);
+    g_free(self->shards_memory);
+    g_free(self->name);
+    G_OBJECT_CLASS(atomic_counter_parent_class)->finalize(object);
+}
+
+static void atomic_counter_class_init(AtomicCounterClass *klass) {
+    GObjectClass *object_class = G_OBJECT_CLASS(klass);
+    
+    object_class->get_property = atomic_counter_get_property;
+    object_class->set_property = atomic_counter_set_property;
+    object_class->constructed = atomic_counter_constructed;
+    object_class->dispose = atomic_counter_dispose;
+    object_class->finalize = atomic_counter_finalize;
+    
+    /* "value" is announced from the counter's main context */
+    atomic_counter_properties[ATOMIC_COUNTER_PROP_VALUE] = 
+        g_param_spec_int64("value", "Value", "Current counter value",
+                          G_MININT64, G_MAXINT64, 0,
+                          G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
+    
+    atomic_counter_properties[ATOMIC_COUNTER_PROP_MINIMUM] = 
+        g_param_spec_int64("minimum", "Minimum", "Lowest allowed value",
+                          G_MININT64, G_MAXINT64, G_MININT64,
+                          G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS);
+    
+    atomic_counter_properties[ATOMIC_COUNTER_PROP_MAXIMUM] = 
+        g_param_spec_int64("maximum", "Maximum", "Highest allowed value",
+                          G_MININT64, G_MAXINT64, G_MAXINT64,
+                          G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS);
+    
+    atomic_counter_properties[ATOMIC_COUNTER_PROP_STEP] = 
+        g_param_spec_int64("step", "Step", "Amount added by increment and removed by decrement",
+                          1, G_MAXINT64, 1,
+                          G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS);
+    
+    atomic_counter_properties[ATOMIC_COUNTER_PROP_NAME] = 
+        g_param_spec_string("name", "Name", "Counter name",
+                           NULL, G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS);
+    
+    atomic_counter_properties[ATOMIC_COUNTER_PROP_SHARDED] = 
+        g_param_spec_boolean("sharded", "Sharded", "Spread increments over per-CPU slots; no bounds",
+                            FALSE, G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS);
+    
+    atomic_counter_properties[ATOMIC_COUNTER_PROP_CONTEXT] = 
+        g_param_spec_boxed("context", "Context", "Main context that emits the signals",
+                          G_TYPE_MAIN_CONTEXT,
+                          G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS);
+    
+    g_object_class_install_properties(object_class, ATOMIC_COUNTER_N_PROPERTIES, atomic_counter_properties);
+    
+    atomic_counter_signals[ATOMIC_COUNTER_SIGNAL_VALUE_CHANGED] = 
+        g_signal_new("value-changed",
+                     G_TYPE_FROM_CLASS(klass),
+                     G_SIGNAL_RUN_FIRST,
+                     0, NULL, NULL,
+                     NULL,
+                     G_TYPE_NONE, 2,
+                     G_TYPE_INT64,  /* last announced value */
+                     G_TYPE_INT64); /* new value */
+    
+    atomic_counter_signals[ATOMIC_COUNTER_SIGNAL_LIMIT_REACHED] = 
+        g_signal_new("limit-reached",
+                     G_TYPE_FROM_CLASS(klass),
+                     G_SIGNAL_RUN_FIRST,
+                     0, NULL, NULL,
+                     NULL,
+                     G_TYPE_NONE, 2,
+                     G_TYPE_INT64,      /* limit value */
+                     G_TYPE_BOOLEAN);   /* is maximum? */
+    
+    atomic_counter_signals[ATOMIC_COUNTER_SIGNAL_RESET] = 
+        g_signal_new("reset",
+                     G_TYPE_FROM_CLASS(klass),
+                     G_SIGNAL_RUN_FIRST,
+                     0, NULL, NULL,
+                     NULL,
+                     G_TYPE_NONE, 0);
+}
+
+static void atomic_counter_init(AtomicCounter *self) {
+    self->name = NULL;
+    self->minimum = G_MININT64;
+    self->maximum = G_MAXINT64;
+    self->step = 1;
+    self->sharded = FALSE;
+    self->context = NULL;
+    self->dispatch_source = NULL;
+    self->last_emitted = 0;
+    self->shards = NULL;
+    self->shards_memory = NULL;
+    self->shard_mask = 0;
+    atomic_init(&self->value, 0);
+    atomic_init(&self->dispatch_pending, FALSE);
+    atomic_init(&self->events, 0);
+}
+
+AtomicCounter* atomic_counter_new(const gchar *name, gint64 initial_value, gint64 min, gint64 max, gint64 step) {
+    g_return_val_if_fail(min <= initial_value && initial_value <= max, NULL);
+    
+    AtomicCounter *self = g_object_new(TYPE_ATOMIC_COUNTER,
+                                       "name", name,
+                                       "minimum", min,
+                                       "maximum", max,
+                                       "step", step,
+                                       NULL);
+    atomic_store(&self->value, initial_value);
+    self->last_emitted = initial_value;
+    return self;
+}
+
+AtomicCounter* atomic_counter_new_sharded(const gchar *name, gint64 step) {
+    return g_object_new(TYPE_ATOMIC_COUNTER,
+                        "name", name,
+                        "step", step,
+                        "sharded", TRUE,
+                        NULL);
+}
+
+// Move a bounded counter one step, or record the bound it would cross
+static gboolean atomic_counter_step_bounded(AtomicCounter *self, gboolean up) {
+    guint64 step = (guint64)self->step;
+    gint64 value = atomic_load_explicit(&self->value, memory_order_relaxed);
+    gint64 next;
+    
+    do {
+        /* value lies within [minimum, maximum], so the distances fit in a guint64 */
+        guint64 room = up ? (guint64)self->maximum - (guint64)value
+                          : (guint64)value - (guint64)self->minimum;
+        if (room < step) {
+            atomic_counter_add_event(self, up ? ATOMIC_COUNTER_HIT_MAXIMUM : ATOMIC_COUNTER_HIT_MINIMUM);
+            return FALSE;
+        }
+        next = (gint64)(up ? (guint64)value + step : (guint64)value - step);
+    } while (!atomic_compare_exchange_weak(&self->value, &value, next));
+    
+    atomic_counter_schedule_dispatch(self);
+    return TRUE;
+}
+
+static inline void atomic_counter_add_to_shard(AtomicCounter *self, gint64 delta) {
+    atomic_fetch_add_explicit(&self->shards[atomic_counter_shard_index(self)].value, delta,
+                              memory_order_relaxed);
+    atomic_counter_schedule_dispatch(self);
+}
+
+gboolean atomic_counter_increment(AtomicCounter *self) {
+    g_return_val_if_fail(IS_ATOMIC_COUNTER(self), FALSE);
+    
+    if (self->sharded) {
+        atomic_counter_add_to_shard(self, self->step);
+        return TRUE;
+    }
+    return atomic_counter_step_bounded(self, TRUE);
+}
+
+gboolean atomic_counter_decrement(AtomicCounter *self) {
+    g_return_val_if_fail(IS_ATOMIC_COUNTER(self), FALSE);
+    
+    if (self->sharded) {
+        atomic_counter_add_to_shard(self, -self->step);
+        return TRUE;
+    }
+    return atomic_counter_step_bounded(self, FALSE);
+}
+
+gboolean atomic_counter_set_value(AtomicCounter *self, gint64 value) {
+    g_return_val_if_fail(IS_ATOMIC_COUNTER(self), FALSE);
+    
+    if (value < self->minimum || value > self->maximum) {
+        return FALSE;
+    }
+    
+    if (self->sharded) {
+        atomic_store_explicit(&self->shards[0].value, value, memory_order_relaxed);
+        for (guint i = 1; i <= self->shard_mask; i++) {
+            atomic_store_explicit(&self->shards[i].value, 0, memory_order_relaxed);
+        }
+    } else {
+        atomic_store(&self->value, value);
+    }
+    atomic_counter_schedule_dispatch(self);
+    
+    return TRUE;
+}
+
+void atomic_counter_reset(AtomicCounter *self) {
+    g_return_if_fail(IS_ATOMIC_COUNTER(self));
+    atomic_counter_set_value(self, 0);
+    atomic_counter_add_event(self, ATOMIC_COUNTER_WAS_RESET);
+}
+
+gint64 atomic_counter_get_value(AtomicCounter *self) {
+    g_return_val_if_fail(IS_ATOMIC_COUNTER(self), 0);
+    
+    if (!self->sharded) {
+        return atomic_load(&self->value);
+    }
+    guint64 sum = 0;
+    for (guint i = 0; i <= self->shard_mask; i++) {
+        sum += (guint64)atomic_load_explicit(&self->shards[i].value, memory_order_relaxed);
+    }
+    return (gint64)sum;
+}
+
+const gchar* atomic_counter_get_name(AtomicCounter *self) {
+    g_return_val_if_fail(IS_ATOMIC_COUNTER(self), NULL);
+    return self->name;
+}
+
+gboolean atomic_counter_is_sharded(AtomicCounter *self) {
+    g_return_val_if_fail(IS_ATOMIC_COUNTER(self), FALSE);
+    return self->sharded;
+}
+
+/* =============================================================================
+ * TaskManager Class Implementation - Indexed Task Store
+ * ============================================================================= */
+
+#define TASK_PRIORITY_HIGH 1
+#define TASK_PRIORITY_LOW 3
+#define TASK_N_PRIORITIES (TASK_PRIORITY_LOW - TASK_PRIORITY_HIGH + 1)
+
+/* Resolution of start times and deadlines */
+#define TASK_MANAGER_TIMER_TICK_US 1000
+
+typedef struct _TaskEntry TaskEntry;
+
+/* Timer of a task with a deferred start or a deadline, allocated on first
+ * use. A deferred task's timer waits for the start; the deadline is armed
+ * once the task has started. */
+typedef struct {
+    TimerWheelEntry entry;
+    TaskEntry *task;
+    gint64 due_us;              /* 0 if the task has no deadline */
+} TaskTimer;
+
+/* Manager-owned task with its list links in the same allocation; the
+ * SignalTask comes first so that a SignalTask* is also a TaskEntry*.
+ * Entries come from an arena; removed ones are reused via next. */
+struct _TaskEntry {
+    SignalTask task;
+    TaskEntry *prev;
+    TaskEntry *next;
+    TaskTimer *timer;           /* NULL for tasks without timers */
+};
+
+typedef struct {
+    TaskEntry *head;
+    TaskEntry *tail;
+    guint length;
+} TaskList;
+
+struct _TaskManager {
+    GObject parent_instance;
+    gchar *name;
+    GHashTable *tasks_by_id;                    /* id -> TaskEntry */
+    TaskList lists[TASK_N_PRIORITIES][2];       /* [priority][completed], oldest first */
+    TaskList deferred;                          /* not started yet */
+    RecordArena *entry_arena;                   /* TaskEntries and TaskTimers */
+    TaskEntry *free_entries;
+    TimerWheelEntry *free_timers;               /* unused TaskTimers, linked by next */
+    TimerWheel *timers;
+    gint next_id;
+    gint total_tasks;
+    gint completed_count;
+};
+
+enum {
+    TASK_MANAGER_PROP_0,
+    TASK_MANAGER_PROP_NAME,
+    TASK_MANAGER_N_PROPERTIES
+};
+
+enum {
+    TASK_MANAGER_SIGNAL_TASK_ADDED,
+    TASK_MANAGER_SIGNAL_TASK_COMPLETED,
+    TASK_MANAGER_SIGNAL_TASK_REMOVED,
+    TASK_MANAGER_SIGNAL_TASK_READY,
+    TASK_MANAGER_SIGNAL_TASK_OVERDUE,
+    TASK_MANAGER_N_SIGNALS
+};
+
+static GParamSpec *task_manager_properties[TASK_MANAGER_N_PROPERTIES] = { NULL, };
+static guint task_manager_signals[TASK_MANAGER_N_SIGNALS] = { 0, };
+
+G_DEFINE_TYPE(TaskManager, task_manager, G_TYPE_OBJECT)
+
+static void signal_task_clear(SignalTask *task) {
+    g_ref_string_release((char*)task->title);
+    if (task->description) {
+        g_ref_string_release((char*)task->description);
+    }
+}
+
+static void signal_task_init(SignalTask *task, gint id, const gchar *title,
+                             const gchar *description, gint priority) {
+    task->id = id;
+    task->flags = (guint8)(priority & SIGNAL_TASK_PRIORITY_MASK);
+    task->title = g_ref_string_new_intern(title);
+    task->description = description ? g_ref_string_new_intern(description) : NULL;
+    task->created_us = g_get_real_time();
+    task->completed_us = 0;
+}
+
+static GDateTime* date_time_from_unix_usec(gint64 usec) {
+    GDateTime *seconds = g_date_time_new_from_unix_local(usec / G_USEC_PER_SEC);
+    GDateTime *date_time = g_date_time_add(seconds, usec % G_USEC_PER_SEC);
+    g_date_time_unref(seconds);
+    return date_time;
+}
+
+SignalTask* signal_task_new(gint id, const gchar *title, const gchar *description, gint priority) {
+    SignalTask *task = g_new(SignalTask, 1);
+    signal_task_init(task, id, title, description, priority);
+    return task;
+}
+
+void signal_task_free(SignalTask *task) {
+    if (task) {
+        signal_task_clear(task);
+        g_free(task);
+    }
+}
+
+GDateTime* signal_task_get_created_at(const SignalTask *task) {
+    g_return_val_if_fail(task != NULL, NULL);
+    return date_time_from_unix_usec(task->created_us);
+}
+
+GDateTime* signal_task_get_completed_at(const SignalTask *task) {
+    g_return_val_if_fail(task != NULL, NULL);
+    return signal_task_is_completed(task) ? date_time_from_unix_usec(task->completed_us) : NULL;
+}
+
+static inline TaskList* task_manager_list_for(TaskManager *self, const SignalTask *task) {
+    if (signal_task_is_deferred(task)) {
+        return &self->deferred;
+    }
+    return &self->lists[signal_task_get_priority(task) - TASK_PRIORITY_HIGH]
+                       [signal_task_is_completed(task) ? 1 : 0];
+}
+
+static TaskEntry* task_manager_entry_new(TaskManager *self) {
+    TaskEntry *entry = self->free_entries;
+    if (entry) {
+        self->free_entries = entry->next;
+        return entry;
+    }
+    return record_arena_alloc(self->entry_arena, sizeof(TaskEntry));
+}
+
+// The entry's strings and timer must already be released
+static void task_manager_entry_free(TaskManager *self, TaskEntry *entry) {
+    entry->next = self->free_entries;
+    self->free_entries = entry;
+}
+
+// Round up so that timers never fire early
+static inline guint64 task_manager_tick_for(gint64 time_us) {
+    guint64 usec = (guint64)MAX(time_us, 0);
+    return (usec + TASK_MANAGER_TIMER_TICK_US - 1) / TASK_MANAGER_TIMER_TICK_US;
+}
+
+static TaskTimer* task_manager_timer_for(TaskManager *self, TaskEntry *entry) {
+    if (entry->timer) {
+        return entry->timer;
+    }
+    
+    TaskTimer *timer = (TaskTimer*)self->free_timers;
+    if (timer) {
+        self->free_timers = timer->entry.next;
+    } else {
+        timer = record_arena_alloc(self->entry_arena, sizeof(TaskTimer));
+    }
+    timer_wheel_entry_init(&timer->entry);
+    timer->task = entry;
+    timer->due_us = 0;
+    entry->timer = timer;
+    return timer;
+}
+
+static void task_manager_timer_free(TaskManager *self, TaskEntry *entry) {
+    TaskTimer *timer = entry->timer;
+    if (timer) {
+        timer_wheel_cancel(self->timers, &timer->entry);
+        timer->entry.next = self->free_timers;
+        self->free_timers = &timer->entry;
+        entry->timer = NULL;
+    }
+}
+
+static void task_list_append(TaskList *list, TaskEntry *entry) {
+    entry->prev = list->tail;
+    entry->next = NULL;
+    if (list->tail) {
+        list->tail->next = entry;
+    } else {
+        list->head = entry;
+    }
+    list->tail = entry;
+    list->length++;
+}
+
+static void task_list_unlink(TaskList *list, TaskEntry *entry) {
+    if (entry->prev) {
+        entry->prev->next = entry->next;
+    } else {
+        list->head = entry->next;
+    }
+    if (entry->next) {
+        entry->next->prev = entry->prev;
+    } else {
+        list->tail = entry->prev;
+    }
+    entry->prev = NULL;
+    entry->next = NULL;
+    list->length--;
+}
+
+static void task_list_collect(const TaskList *list, GPtrArray *out) {
+    for (TaskEntry *entry = list->head; entry; entry = entry->next) {
+        g_ptr_array_add(out, &entry->task);
+    }
+}
+
+static inline gboolean task_manager_has_listeners(TaskManager *self, guint signal_index) {
+    return g_signal_has_handler_pending(self, task_manager_signals[signal_index], 0, TRUE);
+}
+
+static void task_manager_get_property(GObject *object, guint property_id,
+                                      GValue *value, GParamSpec *pspec) {
+    TaskManager *self = TASK_MANAGER(object);
+    
+    switch (property_id) {
+        case TASK_MANAGER_PROP_NAME:
+            g_value_set_string(value, self->name);
+            break;
+        default:
+            G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
+            break;
+    }
+}
+
+static void task_manager_set_property(GObject *object, guint property_id,
+                                      const GValue *value, GParamSpec *pspec) {
+    TaskManager *self = TASK_MANAGER(object);
+    
+    switch (property_id) {
+        case TASK_MANAGER_PROP_NAME:
+            g_free(self->name);
+            self->name = g_value_dup_string(value);
+            break;
+        default:
+            G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
+            break;
+    }
+}
+
+static void task_manager_finalize(GObject *object) {
+    TaskManager *self = TASK_MANAGER(object);
+    
+    g_hash_table_destroy(self->tasks_by_id);
+    for (gint p = 0; p < TASK_N_PRIORITIES; p++) {
+        for (gint state = 0; state < 2; state++) {
+            for (TaskEntry *entry = self->lists[p][state].head; entry; entry = entry->next) {
+                signal_task_clear(&entry->task);
+            }
+        }
+    }
+    for (TaskEntry *entry = self->deferred.head; entry; entry = entry->next) {
+        signal_task_clear(&entry->task);
+    }
+    timer_wheel_free(self->timers);
+    record_arena_free(self->entry_arena);
+    g_free(self->name);
+    
+    G_OBJECT_CLASS(task_manager_parent_class)->finalize(object);
+}
+
+static void task_manager_class_init(TaskManagerClass *klass) {
+    GObjectClass *object_class = G_OBJECT_CLASS(klass);
+    
+    object_class->get_property = task_manager_get_property;
+    object_class->set_property = task_manager_set_property;
+    object_class->finalize = task_manager_finalize;
+    
+    task_manager_properties[TASK_MANAGER_PROP_NAME] = 
+        g_param_spec_string("name", "Name", "Task manager name",
+                           NULL, G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS);
+    
+    g_object_class_install_properties(object_class, TASK_MANAGER_N_PROPERTIES, task_manager_properties);
+    
+    task_manager_signals[TASK_MANAGER_SIGNAL_TASK_ADDED] = 
+        g_signal_new("task-added",
+                     G_TYPE_FROM_CLASS(klass),
+                     G_SIGNAL_RUN_FIRST,
+                     0, NULL, NULL,
+                     NULL,
+                     G_TYPE_NONE, 3,
+                     G_TYPE_INT,     /* task id */
+                     G_TYPE_STRING,  /* title */
+                     G_TYPE_INT);    /* priority */
+    
+    task_manager_signals[TASK_MANAGER_SIGNAL_TASK_COMPLETED] = 
+        g_signal_new("task-completed",
+                     G_TYPE_FROM_CLASS(klass),
+                     G_SIGNAL_RUN_FIRST,
+                     0, NULL, NULL,
+                     NULL,
+                     G_TYPE_NONE, 2,
+                     G_TYPE_INT,     /* task id */
+                     G_TYPE_STRING); /* title */
+    
+    task_manager_signals[TASK_MANAGER_SIGNAL_TASK_REMOVED] = 
+        g_signal_new("task-removed",
+                     G_TYPE_FROM_CLASS(klass),
+                     G_SIGNAL_RUN_FIRST,
+                     0, NULL, NULL,
+                     NULL,
+                     G_TYPE_NONE, 1,
+                     G_TYPE_INT);    /* task id */
+    
+    task_manager_signals[TASK_MANAGER_SIGNAL_TASK_READY] = 
+        g_signal_new("task-ready",
+                     G_TYPE_FROM_CLASS(klass),
+                     G_SIGNAL_RUN_FIRST,
+                     0, NULL, NULL,
+                     NULL,
+                     G_TYPE_NONE, 2,
+                     G_TYPE_INT,     /* task id */
+                     G_TYPE_STRING); /* title */
+    
+    task_manager_signals[TASK_MANAGER_SIGNAL_TASK_OVERDUE] = 
+        g_signal_new("task-overdue",
+                     G_TYPE_FROM_CLASS(klass),
+                     G_SIGNAL_RUN_FIRST,
+                     0, NULL, NULL,
+                     NULL,
+                     G_TYPE_NONE, 3,
+                     G_TYPE_INT,     /* task id */
+                     G_TYPE_STRING,  /* title */
+                     G_TYPE_INT64);  /* deadline, g_get_real_time() microseconds */
+}
+
+static void task_manager_init(TaskManager *self) {
+    self->name = NULL;
+    self->tasks_by_id = g_hash_table_new(g_direct_hash, g_direct_equal);
+    memset(self->lists, 0, sizeof(self->lists));
+    memset(&self->deferred, 0, sizeof(self->deferred));
+    self->entry_arena = record_arena_new(0);
+    self->free_entries = NULL;
+    self->free_timers = NULL;
+    self->timers = timer_wheel_new((guint64)g_get_real_time() / TASK_MANAGER_TIMER_TICK_US);
+    self->next_id = 1;
+    self->total_tasks = 0;
+    self->completed_count = 0;
+}
+
+TaskManager* task_manager_new(const gchar *name) {
+    return g_object_new(TYPE_TASK_MANAGER, "name", name, NULL);
+}
+
+const gchar* task_manager_get_name(TaskManager *self) {
+    g_return_val_if_fail(IS_TASK_MANAGER(self), NULL);
+    return self->name;
+}
+
+// start_us of 0 adds a task that is ready at once
+static gint task_manager_insert(TaskManager *self, const gchar *title, const gchar *description,
+                                gint priority, gint64 start_us) {
+    TaskEntry *entry = task_manager_entry_new(self);
+    signal_task_init(&entry->task, self->next_id++, title, description, priority);
+    entry->timer = NULL;
+    if (start_us > 0) {
+        entry->task.flags |= SIGNAL_TASK_DEFERRED;
+        TaskTimer *timer = task_manager_timer_for(self, entry);
+        timer_wheel_schedule(self->timers, &timer->entry, task_manager_tick_for(start_us));
+    }
+    
+    g_hash_table_insert(self->tasks_by_id, GINT_TO_POINTER(entry->task.id), entry);
+    task_list_append(task_manager_list_for(self, &entry->task), entry);
+    self->total_tasks++;
+    
+    if (task_manager_has_listeners(self, TASK_MANAGER_SIGNAL_TASK_ADDED)) {
+        g_signal_emit(self, task_manager_signals[TASK_MANAGER_SIGNAL_TASK_ADDED], 0,
+                      entry->task.id, entry->task.title, priority);
+    }
+    
+    return entry->task.id;
+}
+
+gint task_manager_add_task(TaskManager *self, const gchar *title, const gchar *description, gint priority) {
+    g_return_val_if_fail(IS_TASK_MANAGER(self), -1);
+    g_return_val_if_fail(title != NULL, -1);
+    g_return_val_if_fail(priority >= TASK_PRIORITY_HIGH && priority <= TASK_PRIORITY_LOW, -1);
+    g_return_val_if_fail(self->next_id < G_MAXINT, -1);
+    
+    return task_manager_insert(self, title, description, priority, 0);
+}
+
+gint task_manager_add_deferred_task(TaskManager *self, const gchar *title, const gchar *description,
+                                    gint priority, gint64 start_us) {
+    g_return_val_if_fail(IS_TASK_MANAGER(self), -1);
+    g_return_val_if_fail(title != NULL, -1);
+    g_return_val_if_fail(priority >= TASK_PRIORITY_HIGH && priority <= TASK_PRIORITY_LOW, -1);
+    g_return_val_if_fail(self->next_id < G_MAXINT, -1);
+    g_return_val_if_fail(start_us > 0, -1);
+    
+    return task_manager_insert(self, title, description, priority, start_us);
+}
+
+gboolean task_manager_complete_task(TaskManager *self, gint task_id) {
+    g_return_val_if_fail(IS_TASK_MANAGER(self), FALSE);
+    
+    TaskEntry *entry = g_hash_table_lookup(self->tasks_by_id, GINT_TO_POINTER(task_id));
+    if (!entry || signal_task_is_completed(&entry->task)) {
+        return FALSE;
+    }
+    
+    if (entry->timer) {
+        timer_wheel_cancel(self->timers, &entry->timer->entry);
+    }
+    task_list_unlink(task_manager_list_for(self, &entry->task), entry);
+    entry->task.flags = (entry->task.flags & ~SIGNAL_TASK_DEFERRED) | SIGNAL_TASK_COMPLETED;
+    entry->task.completed_us = g_get_real_time();
+    task_list_append(task_manager_list_for(self, &entry->task), entry);
+    self->completed_count++;
+    
+    if (task_manager_has_listeners(self, TASK_MANAGER_SIGNAL_TASK_COMPLETED)) {
+        g_signal_emit(self, task_manager_signals[TASK_MANAGER_SIGNAL_TASK_COMPLETED], 0,
+                      task_id, entry->task.title);
+    }
+    
+    return TRUE;
+}
+
+gboolean task_manager_remove_task(TaskManager *self, gint task_id) {
+    g_return_val_if_fail(IS_TASK_MANAGER(self), FALSE);
+    
+    TaskEntry *entry = g_hash_table_lookup(self->tasks_by_id, GINT_TO_POINTER(task_id));
+    if (!entry) {
+        return FALSE;
+    }
+    
+    g_hash_table_remove(self->tasks_by_id, GINT_TO_POINTER(task_id));
+    task_list_unlink(task_manager_list_for(self, &entry->task), entry);
+    self->total_tasks--;
+    if (signal_task_is_completed(&entry->task)) {
+        self->completed_count--;
+    }
+    task_manager_timer_free(self, entry);
+    signal_task_clear(&entry->task);
+    task_manager_entry_free(self, entry);
+    
+    if (task_manager_has_listeners(self, TASK_MANAGER_SIGNAL_TASK_REMOVED)) {
+        g_signal_emit(self, task_manager_signals[TASK_MANAGER_SIGNAL_TASK_REMOVED], 0, task_id);
+    }
+    
+    return TRUE;
+}
+
+SignalTask* task_manager_get_task(TaskManager *self, gint task_id) {
+    g_return_val_if_fail(IS_TASK_MANAGER(self), NULL);
+    
+    TaskEntry *entry = g_hash_table_lookup(self->tasks_by_id, GINT_TO_POINTER(task_id));
+    return entry ? &entry->task : NULL;
+}
+
+gboolean task_manager_set_task_deadline(TaskManager *self, gint task_id, gint64 due_us) {
+    g_return_val_if_fail(IS_TASK_MANAGER(self), FALSE);
+    g_return_val_if_fail(due_us >= 0, FALSE);
+    
+    TaskEntry *entry = g_hash_table_lookup(self->tasks_by_id, GINT_TO_POINTER(task_id));
+    if (!entry || signal_task_is_completed(&entry->task)) {
+        return FALSE;
+    }
+    
+    entry->task.flags &= ~SIGNAL_TASK_OVERDUE;
+    if (signal_task_is_deferred(&entry->task)) {
+        // The start timer arms the deadline
+        task_manager_timer_for(self, entry)->due_us = due_us;
+    } else if (due_us == 0) {
+        task_manager_timer_free(self, entry);
+    } else {
+        TaskTimer *timer = task_manager_timer_for(self, entry);
+        timer->due_us = due_us;
+        timer_wheel_schedule(self->timers, &timer->entry, task_manager_tick_for(due_us));
+    }
+    return TRUE;
+}
+
+gint64 task_manager_get_task_deadline(TaskManager *self, gint task_id) {
+    g_return_val_if_fail(IS_TASK_MANAGER(self), 0);
+    
+    TaskEntry *entry = g_hash_table_lookup(self->tasks_by_id, GINT_TO_POINTER(task_id));
+    return entry && entry->timer ? entry->timer->due_us : 0;
+}
+
+/* A deferred task reaching its start time, or a deadline passing. The
+ * timer stays with the task to keep its deadline. */
+static void task_manager_timer_expired(TimerWheelEntry *wheel_entry, gpointer user_data) {
+    TaskManager *self = user_data;
+    TaskTimer *timer = (TaskTimer*)wheel_entry;
+    TaskEntry *entry = timer->task;
+    
+    if (signal_task_is_deferred(&entry->task)) {
+        task_list_unlink(&self->deferred, entry);
+        entry->task.flags &= ~SIGNAL_TASK_DEFERRED;
+        task_list_append(task_manager_list_for(self, &entry->task), entry);
+        if (timer->due_us != 0) {
+            timer_wheel_schedule(self->timers, &timer->entry, task_manager_tick_for(timer->due_us));
+        }
+        
+        if (task_manager_has_listeners(self, TASK_MANAGER_SIGNAL_TASK_READY)) {
+            g_signal_emit(self, task_manager_signals[TASK_MANAGER_SIGNAL_TASK_READY], 0,
+                          entry->task.id, entry->task.title);
+        }
+        return;
+    }
+    
+    entry->task.flags |= SIGNAL_TASK_OVERDUE;
+    if (task_manager_has_listeners(self, TASK_MANAGER_SIGNAL_TASK_OVERDUE)) {
+        g_signal_emit(self, task_manager_signals[TASK_MANAGER_SIGNAL_TASK_OVERDUE], 0,
+                      entry->task.id, entry->task.title, timer->due_us);
+    }
+}
+
+guint task_manager_process_timers(TaskManager *self, gint64 now_us) {
+    g_return_val_if_fail(IS_TASK_MANAGER(self), 0);
+    g_return_val_if_fail(now_us >= 0, 0);
+    
+    return timer_wheel_advance(self->timers, (guint64)now_us / TASK_MANAGER_TIMER_TICK_US,
+                               task_manager_timer_expired, self);
+}
+
+gint64 task_manager_get_next_timer_us(TaskManager *self) {
+    g_return_val_if_fail(IS_TASK_MANAGER(self), -1);
+    
+    guint64 tick = timer_wheel_get_next_tick(self->timers);
+    return tick == G_MAXUINT64 ? -1 : (gint64)(tick * TASK_MANAGER_TIMER_TICK_US);
+}
+
+GPtrArray* task_manager_get_tasks_by_priority(TaskManager *self, gint priority) {
+    g_return_val_if_fail(IS_TASK_MANAGER(self), NULL);
+    g_return_val_if_fail(priority >= TASK_PRIORITY_HIGH && priority <= TASK_PRIORITY_LOW, NULL);
+    
+    TaskList *lists = self->lists[priority - TASK_PRIORITY_HIGH];
+    GPtrArray *tasks = g_ptr_array_sized_new(lists[0].length + lists[1].length);
+    task_list_collect(&lists[0], tasks);
+    task_list_collect(&lists[1], tasks);
+    return tasks;
+}
+
+static GPtrArray* task_manager_collect_state(TaskManager *self, gint state) {
+    guint length = 0;
+    for (gint p = 0; p < TASK_N_PRIORITIES; p++) {
+        length += self->lists[p][state].length;
+    }
+    
+    GPtrArray *tasks = g_ptr_array_sized_new(length);
+    for (gint p = 0; p < TASK_N_PRIORITIES; p++) {
+        task_list_collect(&self->lists[p][state], tasks);
+    }
+    return tasks;
+}
+
+GPtrArray* task_manager_get_pending_tasks(TaskManager *self) {
+    g_return_val_if_fail(IS_TASK_MANAGER(self), NULL);
+    return task_manager_collect_state(self, 0);
+}
+
+GPtrArray* task_manager_get_completed_tasks(TaskManager *self) {
+    g_return_val_if_fail(IS_TASK_MANAGER(self), NULL);
+    return task_manager_collect_state(self, 1);
+}
+
+gint task_manager_get_total_tasks(TaskManager *self) {
+    g_return_val_if_fail(IS_TASK_MANAGER(self), 0);
+    return self->total_tasks;
+}
+
+gint task_manager_get_completed_count(TaskManager *self) {
+    g_return_val_if_fail(IS_TASK_MANAGER(self), 0);
+    return self->completed_count;
+}
+
+gdouble task_manager_get_completion_percentage(TaskManager *self) {
+    g_return_val_if_fail(IS_TASK_MANAGER(self), 0.0);
+    
+    if (self->total_tasks == 0) {
+        return 0.0;
+    }
+    return 100.0 * self->completed_count / self->total_tasks;
+}
+
+/* =============================================================================
+ * Event Logger Implementation
+ * ============================================================================= */
+
+/* Single-producer ring of one thread's records; only the owning thread
+ * advances tail and only the writer thread advances head. Shared by the
+ * logger's session and the owning thread's list, each holding a reference. */
+typedef struct {
+    atomic_uint_fast32_t head;
+    atomic_uint_fast32_t tail;
+    guint32 mask;
+    gint ref_count;             /* atomic */
+    gint closed;                /* atomic; the session has stopped */
+    EventRecord *records;
+} EventRing;
+
+struct _EventLogger {
+    GObject parent_instance;
+    gchar *log_name;
+    FILE *log_file;
+    EventLogWriter *binary_log;     /* replaces the text output when set */
+    GMutex binary_lock;             /* serializes appends from handler threads */
+    
+    /* Async mode: set up by event_logger_start_async() */
+    gint async;                 /* atomic */
+    gint enqueuers;             /* atomic; handlers inside event_logger_enqueue() */
+    guint64 session;            /* identifies this logger's rings in each thread */
+    guint32 ring_capacity;
+    EventLoggerFullPolicy full_policy;
+    gint64 flush_interval_us;
+    GThread *writer;
+    GMutex lock;                /* guards everything below */
+    GCond wake_writer;
+    GCond room;                 /* the writer drained the rings */
+    GCond flushed;
+    GPtrArray *rings;
+    guint waiting_producers;
+    guint64 flush_requests;
+    guint64 flushes_done;
+    gboolean stopping;
+    
+    atomic_uint_fast64_t logged;
+    atomic_uint_fast64_t dropped;
+    atomic_uint_fast64_t blocked;
+    atomic_uint_fast64_t batches;
+};
+
+G_DEFINE_TYPE(EventLogger, event_logger, G_TYPE_OBJECT)
+
+static void event_logger_finalize(GObject *object) {
+    EventLogger *self = EVENT_LOGGER(object);
+    
+    event_logger_stop_async(self);
+    g_free(self->log_name);
+    if (self->log_file && self->log_file != stdout) {
+        fclose(self->log_file);
+    }
+    event_log_writer_free(self->binary_log);
+    g_mutex_clear(&self->binary_lock);
+    g_cond_clear(&self->flushed);
+    g_cond_clear(&self->room);
+    g_cond_clear(&self->wake_writer);
+    g_mutex_clear(&self->lock);
+    
+    G_OBJECT_CLASS(event_logger_parent_class)->finalize(object);
+}
+
+static void event_logger_class_init(EventLoggerClass *klass) {
+    GObjectClass *object_class = G_OBJECT_CLASS(klass);
+    object_class->finalize = event_logger_finalize;
+}
+
+static void event_logger_init(EventLogger *self) {
+    self->log_name = NULL;
+    self->log_file = stdout;  /* Default to stdout */
+    self->binary_log = NULL;
+    g_mutex_init(&self->binary_lock);
+    self->async = FALSE;
+    self->enqueuers = 0;
+    self->writer = NULL;
+    self->rings = NULL;
+    g_mutex_init(&self->lock);
+    g_cond_init(&self->wake_writer);
+    g_cond_init(&self->room);
+    g_cond_init(&self->flushed);
+    atomic_init(&self->logged, 0);
+    atomic_init(&self->dropped, 0);
+    atomic_init(&self->blocked, 0);
+    atomic_init(&self->batches, 0);
+}
+
+EventLogger* event_logger_new(const gchar *log_name) {
+    EventLogger *logger = g_object_new(TYPE_EVENT_LOGGER, NULL);
+    logger->log_name = g_strdup(log_name);
+    return logger;
+}
+
+gboolean event_logger_set_log_file(EventLogger *self, const gchar *path) {
+    g_return_val_if_fail(IS_EVENT_LOGGER(self), FALSE);
+    g_return_val_if_fail(path != NULL, FALSE);
+    g_return_val_if_fail(!g_atomic_int_get(&self->async), FALSE);
+    
+    FILE *file = fopen(path, "a");
+    if (!file) {
+        return FALSE;
+    }
+    if (self->log_file && self->log_file != stdout) {
+        fclose(self->log_file);
+    }
+    self->log_file = file;
+    return TRUE;
+}
+
+gboolean event_logger_set_binary_log(EventLogger *self, const gchar *directory,
+                                     guint64 segment_bytes, GError **error) {
+    g_return_val_if_fail(IS_EVENT_LOGGER(self), FALSE);
+    g_return_val_if_fail(directory != NULL, FALSE);
+    g_return_val_if_fail(!g_atomic_int_get(&self->async), FALSE);
+    
+    EventLogWriter *writer = event_log_writer_new(directory, segment_bytes, error);
+    if (!writer) {
+        return FALSE;
+    }
+    g_mutex_lock(&self->binary_lock);
+    event_log_writer_free(self->binary_log);
+    g_atomic_pointer_set(&self->binary_log, writer);
+    g_mutex_unlock(&self->binary_lock);
+    return TRUE;
+}
+
+/* Print a record whose strings are given separately, so that synchronous
+ * text output can pass them untruncated */
+static void event_record_print_strings(const EventRecord *record, const gchar *source, const gchar *peer,
+                                       const gchar *text, const gchar *log_name, FILE *out) {
+    switch ((EventRecordKind)record->kind) {
+        case EVENT_RECORD_DEPOSIT:
+            fprintf(out, "[%s] DEPOSIT: $%.2f - %s (New Balance: $%.2f) [Account: %s]\n",
+                    log_name, record->amounts[0], text, record->amounts[2], source);
+            break;
+        case EVENT_RECORD_WITHDRAWAL:
+            fprintf(out, "[%s] WITHDRAWAL: $%.2f - %s (New Balance: $%.2f) [Account: %s]\n",
+                    log_name, record->amounts[0], text, record->amounts[2], source);
+            break;
+        case EVENT_RECORD_TRANSFER_OUT:
+            fprintf(out, "[%s] TRANSFER OUT: $%.2f to %s - %s (New Balance: $%.2f) [Account: %s]\n",
+                    log_name, record->amounts[0], peer, text,
+                    record->amounts[2], source);
+            break;
+        case EVENT_RECORD_TRANSFER_IN:
+            fprintf(out, "[%s] TRANSFER IN: $%.2f from %s - %s (New Balance: $%.2f) [Account: %s]\n",
+                    log_name, record->amounts[0], peer, text,
+                    record->amounts[2], source);
+            break;
+        case EVENT_RECORD_BATCH:
+            fprintf(out, "[%s] BATCH: %d applied, %d rejected, +$%.2f / -$%.2f "
+                    "(New Balance: $%.2f) [Account: %s]\n",
+                    log_name, record->counts[0], record->counts[1], record->amounts[0],
+                    record->amounts[1], record->amounts[2], source);
+            break;
+        case EVENT_RECORD_LOW_BALANCE:
+            fprintf(out, "[%s] WARNING: Low balance $%.2f [Account: %s]\n",
+                    log_name, record->amounts[2], source);
+            break;
+        case EVENT_RECORD_COUNTER:
+            fprintf(out, "[%s] COUNTER '%s': %d -> %d\n",
+                    log_name, source, record->counts[0], record->counts[1]);
+            break;
+        case EVENT_RECORD_TASK_ADDED:
+            fprintf(out, "[%s] TASK ADDED: #%d %s (priority %d) [Manager: %s]\n",
+                    log_name, record->counts[0], text, record->counts[1], source);
+            break;
+        case EVENT_RECORD_TASK_COMPLETED:
+            fprintf(out, "[%s] TASK COMPLETED: #%d %s [Manager: %s]\n",
+                    log_name, record->counts[0], text, source);
+            break;
+        case EVENT_RECORD_TASK_REMOVED:
+            fprintf(out, "[%s] TASK REMOVED: #%d [Manager: %s]\n",
+                    log_name, record->counts[0], source);
+            break;
+        case EVENT_RECORD_TASK_READY:
+            fprintf(out, "[%s] TASK READY: #%d %s [Manager: %s]\n",
+                    log_name, record->counts[0], text, source);
+            break;
+        case EVENT_RECORD_TASK_OVERDUE:
+            fprintf(out, "[%s] TASK OVERDUE: #%d %s (%.0f s past deadline) [Manager: %s]\n",
+                    log_name, record->counts[0], text,
+                    ((gdouble)record->timestamp_us - record->amounts[1]) / G_USEC_PER_SEC, source);
+            break;
+        default:
+            fprintf(out, "[%s] UNKNOWN EVENT %u\n", log_name, record->kind);
+            break;
+    }
+}
+
+void event_record_print(const EventRecord *record, const gchar *log_name, FILE *out) {
+    g_return_if_fail(record != NULL && out != NULL);
+    event_record_print_strings(record, record->source, record->peer, record->text, log_name, out);
+}
+
+/* Output records; runs in the emitting thread (sync mode) or the writer thread */
+static void event_logger_write_records(EventLogger *self, const EventRecord *records, gsize n_records) {
+    if (g_atomic_pointer_get(&self->binary_log)) {
+        gboolean written = FALSE;
+        g_mutex_lock(&self->binary_lock);
+        EventLogWriter *writer = self->binary_log;
+        if (writer) {
+            GError *error = NULL;
+            written = event_log_writer_append(writer, records, n_records, &error);
+            if (!written) {
+                g_warning("Event logger %s: %s; switching to text output", self->log_name, error->message);
+                g_error_free(error);
+                g_atomic_pointer_set(&self->binary_log, NULL);
+                event_log_writer_free(writer);
+            }
+        }
+        g_mutex_unlock(&self->binary_lock);
+        if (written) {
+            atomic_fetch_add_explicit(&self->logged, n_records, memory_order_relaxed);
+            return;
+        }
+    }
+    
+    for (gsize i = 0; i < n_records; i++) {
+        event_record_print(&records[i], self->log_name, self->log_file);
+    }
+    atomic_fetch_add_explicit(&self->logged, n_records, memory_order_relaxed);
+}
+
+static void event_logger_flush_output(EventLogger *self) {
+    g_mutex_lock(&self->binary_lock);
+    if (self->binary_log) {
+        event_log_writer_flush(self->binary_log, NULL);
+    }
+    g_mutex_unlock(&self->binary_lock);
+    fflush(self->log_file);
+}
+
+/* =============================================================================
+ * Asynchronous Event Logging
+ * ============================================================================= */
+
+/* Each thread keeps a list of the rings it owns, newest async session first.
+ * Entries of stopped sessions are never matched again; they are pruned the
+ * next time the thread creates a ring, or when it exits. */
+typedef struct _EventRingRef EventRingRef;
+
+struct _EventRingRef {
+    guint64 session;
+    EventRing *ring;
+    EventRingRef *next;
+};
+
+static EventRing* event_ring_new(guint32 capacity) {
+    EventRing *ring = g_new(EventRing, 1);
+    atomic_init(&ring->head, 0);
+    atomic_init(&ring->tail, 0);
+    ring->mask = capacity - 1;
+    ring->ref_count = 2;
+    ring->closed = FALSE;
+    ring->records = g_new(EventRecord, capacity);
+    return ring;
+}
+
+static void event_ring_unref(EventRing *ring) {
+    if (g_atomic_int_dec_and_test(&ring->ref_count)) {
+        g_free(ring->records);
+        g_free(ring);
+    }
+}
+
+// Free function of the logger's ring array: ends the session's hold on a ring
+static void event_ring_close(gpointer data) {
+    EventRing *ring = (EventRing*)data;
+    g_atomic_int_set(&ring->closed, TRUE);
+    event_ring_unref(ring);
+}
+
+static void event_ring_refs_free(gpointer data) {
+    EventRingRef *ref = (EventRingRef*)data;
+    while (ref) {
+        EventRingRef *next = ref->next;
+        event_ring_unref(ref->ring);
+        g_free(ref);
+        ref = next;
+    }
+}
+
+static GPrivate thread_rings = G_PRIVATE_INIT(event_ring_refs_free);
+static atomic_uint_fast64_t event_logger_sessions;
+
+// Drop the calling thread's entries for stopped sessions
+static EventRingRef* event_ring_refs_prune(EventRingRef *refs) {
+    EventRingRef **link = &refs;
+    while (*link) {
+        EventRingRef *ref = *link;
+        if (g_atomic_int_get(&ref->ring->closed)) {
+            *link = ref->next;
+            event_ring_unref(ref->ring);
+            g_free(ref);
+        } else {
+            link = &ref->next;
+        }
+    }
+    return refs;
+}
+
+// The calling thread's ring for the current session, created on first use
+static EventRing* event_logger_thread_ring(EventLogger *self) {
+    EventRingRef *refs = g_private_get(&thread_rings);
+    for (EventRingRef *ref = refs; ref; ref = ref->next) {
+        if (ref->session == self->session) {
+            return ref->ring;
+        }
+    }
+    
+    EventRing *ring = event_ring_new(self->ring_capacity);
+    g_mutex_lock(&self->lock);
+    g_ptr_array_add(self->rings, ring);
+    g_mutex_unlock(&self->lock);
+    
+    EventRingRef *ref = g_new(EventRingRef, 1);
+    ref->session = self->session;
+    ref->ring = ring;
+    ref->next = event_ring_refs_prune(refs);
+    g_private_set(&thread_rings, ref);
+    return ring;
+}
+
+// Write out everything the owning thread has published so far, as at most
+// two contiguous runs of the ring
+static guint32 event_ring_drain(EventLogger *self, EventRing *ring) {
+    guint32 head = (guint32)atomic_load_explicit(&ring->head, memory_order_relaxed);
+    guint32 tail = (guint32)atomic_load_explicit(&ring->tail, memory_order_acquire);
+    guint32 pending = tail - head;
+    if (pending == 0) {
+        return 0;
+    }
+    
+    guint32 start = head & ring->mask;
+    guint32 first = MIN(pending, ring->mask + 1 - start);
+    event_logger_write_records(self, &ring->records[start], first);
+    if (first < pending) {
+        event_logger_write_records(self, ring->records, pending - first);
+    }
+    atomic_store_explicit(&ring->head, tail, memory_order_release);
+    return pending;
+}
+
+static gpointer event_logger_writer(gpointer data) {
+    EventLogger *self = EVENT_LOGGER(data);
+    GPtrArray *snapshot = g_ptr_array_new();
+    
+    g_mutex_lock(&self->lock);
+    for (;;) {
+        guint64 request = self->flush_requests;
+        gboolean stopping = self->stopping;
+        g_ptr_array_set_size(snapshot, 0);
+        for (guint i = 0; i < self->rings->len; i++) {
+            g_ptr_array_add(snapshot, g_ptr_array_index(self->rings, i));
+        }
+        g_mutex_unlock(&self->lock);
+        
+        /* Format and flush without the lock so that handlers never wait on I/O */
+        guint64 written = 0;
+        for (guint i = 0; i < snapshot->len; i++) {
+            written += event_ring_drain(self, g_ptr_array_index(snapshot, i));
+        }
+        if (written > 0) {
+            event_logger_flush_output(self);
+            atomic_fetch_add_explicit(&self->batches, 1, memory_order_relaxed);
+        }
+        
+        g_mutex_lock(&self->lock);
+        if (self->waiting_producers > 0) {
+            g_cond_broadcast(&self->room);
+        }
+        /* Handlers were quiesced before stopping was set, so the last pass
+         * also covers flushes requested while it ran */
+        self->flushes_done = stopping ? self->flush_requests : request;
+        g_cond_broadcast(&self->flushed);
+        if (stopping) {
+            break;
+        }
+        if (self->flush_requests == request && self->waiting_producers == 0 && !self->stopping) {
+            g_cond_wait_until(&self->wake_writer, &self->lock,
+                              g_get_monotonic_time() + self->flush_interval_us);
+        }
+    }
+    g_mutex_unlock(&self->lock);
+    
+    g_ptr_array_free(snapshot, TRUE);
+    return NULL;
+}
+
+// Hand a record to its ring, applying the full policy. Returns FALSE if
+// logging stopped being asynchronous while the handler waited for room.
+static gboolean event_logger_enqueue(EventLogger *self, const EventRecord *record) {
+    EventRing *ring = event_logger_thread_ring(self);
+    guint32 tail = (guint32)atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    guint32 head = (guint32)atomic_load_explicit(&ring->head, memory_order_acquire);
+    
+    if (tail - head > ring->mask) {
+        if (self->full_policy == EVENT_LOGGER_FULL_DROP) {
+            atomic_fetch_add_explicit(&self->dropped, 1, memory_order_relaxed);
+            return TRUE;
+        }
+        
+        atomic_fetch_add_explicit(&self->blocked, 1, memory_order_relaxed);
+        gboolean async = TRUE;
+        g_mutex_lock(&self->lock);
+        self->waiting_producers++;
+        g_cond_signal(&self->wake_writer);
+        while (tail - (guint32)atomic_load_explicit(&ring->head, memory_order_acquire) > ring->mask) {
+            async = g_atomic_int_get(&self->async);
+            if (!async) {
+                break;
+            }
+            g_cond_wait(&self->room, &self->lock);
+        }
+        self->waiting_producers--;
+        g_mutex_unlock(&self->lock);
+        if (!async) {
+            return FALSE;
+        }
+    }
+    
+    ring->records[tail & ring->mask] = *record;
+    atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+    
+    /* Wake the writer early once the ring is half full. The signal is sent
+     * without the lock, so it may be missed; the flush interval bounds that. */
+    if (tail + 1 - head == (ring->mask + 1) / 2) {
+        g_cond_signal(&self->wake_writer);
+    }
+    return TRUE;
+}
+
+static void event_logger_log(EventLogger *self, const EventRecord *record) {
+    if (g_atomic_int_get(&self->async)) {
+        /* Announce the handler before checking again, so that
+         * event_logger_stop_async() either waits for it or it sees async
+         * cleared and writes synchronously */
+        g_atomic_int_inc(&self->enqueuers);
+        gboolean queued = g_atomic_int_get(&self->async) && event_logger_enqueue(self, record);
+        g_atomic_int_add(&self->enqueuers, -1);
+        if (queued) {
+            return;
+        }
+    }
+    event_logger_write_records(self, record, 1);
+}
+
+gboolean event_logger_start_async(EventLogger *self, guint ring_capacity, guint flush_interval_ms,
+                                  EventLoggerFullPolicy policy) {
+    g_return_val_if_fail(IS_EVENT_LOGGER(self), FALSE);
+    g_return_val_if_fail(ring_capacity > 0 && ring_capacity <= (1u << 30), FALSE);
+    g_return_val_if_fail(flush_interval_ms > 0, FALSE);
+    
+    if (g_atomic_int_get(&self->async)) {
+        return FALSE;
+    }
+    
+    guint32 capacity = 1;
+    while (capacity < ring_capacity) {
+        capacity <<= 1;
+    }
+    
+    self->session = atomic_fetch_add_explicit(&event_logger_sessions, 1, memory_order_relaxed) + 1;
+    self->ring_capacity = capacity;
+    self->full_policy = policy;
+    self->flush_interval_us = (gint64)flush_interval_ms * 1000;
+    self->rings = g_ptr_array_new_with_free_func(event_ring_close);
+    self->waiting_producers = 0;
+    self->flush_requests = 0;
+    self->flushes_done = 0;
+    self->stopping = FALSE;
+    self->writer = g_thread_new("event-logger", event_logger_writer, self);
+    g_atomic_int_set(&self->async, TRUE);
+    
+    return TRUE;
+}
+
+void event_logger_flush(EventLogger *self) {
+    g_return_if_fail(IS_EVENT_LOGGER(self));
+    
+    if (!g_atomic_int_get(&self->async)) {
+        event_logger_flush_output(self);
+        return;
+    }
+    
+    g_mutex_lock(&self->lock);
+    guint64 request = ++self->flush_requests;
+    g_cond_signal(&self->wake_writer);
+    while (self->flushes_done < request) {
+        g_cond_wait(&self->flushed, &self->lock);
+    }
+    g_mutex_unlock(&self->lock);
+}
+
+void event_logger_stop_async(EventLogger *self) {
+    g_return_if_fail(IS_EVENT_LOGGER(self));
+    
+    if (!g_atomic_int_compare_and_exchange(&self->async, TRUE, FALSE)) {
+        return;
+    }
+    
+    /* New events now take the synchronous path. Release handlers waiting
+     * for room, then wait for those already enqueueing to publish their
+     * records; the writer keeps draining meanwhile. */
+    g_mutex_lock(&self->lock);
+    g_cond_broadcast(&self->room);
+    g_mutex_unlock(&self->lock);
+    while (g_atomic_int_get(&self->enqueuers) > 0) {
+        g_thread_yield();
+    }
+    
+    /* The writer drains every ring once more before it exits */
+    g_mutex_lock(&self->lock);
+    self->stopping = TRUE;
+    g_cond_signal(&self->wake_writer);
+    g_mutex_unlock(&self->lock);
+    g_thread_join(self->writer);
+    self->writer = NULL;
+    
+    /* Rings stay allocated until their threads have dropped them too */
+    g_ptr_array_free(self->rings, TRUE);
+    self->rings = NULL;
+}
+
+void event_logger_get_stats(EventLogger *self, EventLoggerStats *stats) {
+    g_return_if_fail(IS_EVENT_LOGGER(self));
+    g_return_if_fail(stats != NULL);
+    
+    stats->logged = atomic_load_explicit(&self->logged, memory_order_relaxed);
+    stats->dropped = atomic_load_explicit(&self->dropped, memory_order_relaxed);
+    stats->blocked = atomic_load_explicit(&self->blocked, memory_order_relaxed);
+    stats->batches = atomic_load_explicit(&self->batches, memory_order_relaxed);
+}
+
+/* =============================================================================
+ * Event Logger Signal Handlers
+ * ============================================================================= */
+
+static void event_record_init(EventRecord *record, EventRecordKind kind) {
+    memset(record, 0, sizeof(EventRecord));
+    record->timestamp_us = g_get_real_time();
+    record->kind = kind;
+}
+
+// Copy src into a record field of size bytes, cutting it before the first
+// UTF-8 character that does not fit
+static void event_record_set_string(gchar *field, const gchar *src, gsize size) {
+    if (!src) {
+        return;
+    }
+    gsize len = strlen(src);
+    if (len >= size) {
+        const gchar *end = g_utf8_find_prev_char(src, src + size);
+        len = end ? (gsize)(end - src) : 0;
+    }
+    memcpy(field, src, len);
+    field[len] = '\0';
+}
+
+// Log an event whose numbers are in record. Synchronous text output prints
+// the strings in full; otherwise they are copied into the record.
+static void event_logger_log_event(EventLogger *self, EventRecord *record, const gchar *source,
+                                   const gchar *peer, const gchar *text) {
+    if (!g_atomic_int_get(&self->async) && !g_atomic_pointer_get(&self->binary_log)) {
+        event_record_print_strings(record, source, peer, text, self->log_name, self->log_file);
+        atomic_fetch_add_explicit(&self->logged, 1, memory_order_relaxed);
+        return;
+    }
+    
+    event_record_set_string(record->source, source, sizeof(record->source));
+    event_record_set_string(record->peer, peer, sizeof(record->peer));
+    event_record_set_string(record->text, text, sizeof(record->text));
+    event_logger_log(self, record);
+}
+
+/* Signal handlers for bank account */
+static void on_bank_deposit(BankAccount *account, gdouble amount, const gchar *description, 
+                           gdouble new_balance, EventLogger *logger) {
+    EventRecord record;
+    event_record_init(&record, EVENT_RECORD_DEPOSIT);
+    record.amounts[0] = amount;
+    record.amounts[2] = new_balance;
+    event_logger_log_event(logger, &record, bank_account_get_account_number(account), NULL, description);
+}
+
+static void on_bank_withdrawal(BankAccount *account, gdouble amount, const gchar *description,
+                              gdouble new_balance, EventLogger *logger) {
+    EventRecord record;
+    event_record_init(&record, EVENT_RECORD_WITHDRAWAL);
+    record.amounts[0] = amount;
+    record.amounts[2] = new_balance;
+    event_logger_log_event(logger, &record, bank_account_get_account_number(account), NULL, description);
+}
+
+static void on_transfer_out(BankAccount *account, BankAccount *destination, gdouble amount,
+                            const gchar *description, gdouble new_balance, EventLogger *logger) {
+    EventRecord record;
+    event_record_init(&record, EVENT_RECORD_TRANSFER_OUT);
+    record.amounts[0] = amount;
+    record.amounts[2] = new_balance;
+    event_logger_log_event(logger, &record, bank_account_get_account_number(account),
+                           bank_account_get_account_number(destination), description);
+}
+
+static void on_transfer_in(BankAccount *account, BankAccount *source, gdouble amount,
+                           const gchar *description, gdouble new_balance, EventLogger *logger) {
+    EventRecord record;
+    event_record_init(&record, EVENT_RECORD_TRANSFER_IN);
+    record.amounts[0] = amount;
+    record.amounts[2] = new_balance;
+    event_logger_log_event(logger, &record, bank_account_get_account_number(account),
+                           bank_account_get_account_number(source), description);
+}
+
+static void on_batch_applied(BankAccount *account, guint applied, guint rejected,
+                             gdouble deposited, gdouble withdrawn, gdouble new_balance,
+                             EventLogger *logger) {
+    EventRecord record;
+    event_record_init(&record, EVENT_RECORD_BATCH);
+    record.counts[0] = (gint32)MIN(applied, (guint)G_MAXINT32);
+    record.counts[1] = (gint32)MIN(rejected, (guint)G_MAXINT32);
+    record.amounts[0] = deposited;
+    record.amounts[1] = withdrawn;
+    record.amounts[2] = new_balance;
+    event_logger_log_event(logger, &record, bank_account_get_account_number(account), NULL, NULL);
+}
+
+static void on_low_balance(BankAccount *account, gdouble balance, EventLogger *logger) {
+    EventRecord record;
+    event_record_init(&record, EVENT_RECORD_LOW_BALANCE);
+    record.amounts[2] = balance;
+    event_logger_log_event(logger, &record, bank_account_get_account_number(account), NULL, NULL);
+}
+
+void event_logger_connect_to_bank_account(EventLogger *self, BankAccount *account) {
+    g_signal_connect(account, "deposit", G_CALLBACK(on_bank_deposit), self);
+    g_signal_connect(account, "withdrawal", G_CALLBACK(on_bank_withdrawal), self);
+    g_signal_connect(account, "low-balance", G_CALLBACK(on_low_balance), self);
+    g_signal_connect(account, "transfer-out", G_CALLBACK(on_transfer_out), self);
+    g_signal_connect(account, "transfer-in", G_CALLBACK(on_transfer_in), self);
+    g_signal_connect(account, "batch-applied", G_CALLBACK(on_batch_applied), self);
+}
+
+/* Signal handlers for counter */
+static void on_counter_value_changed(Counter *counter, gint old_value, gint new_value, EventLogger *logger) {
+    EventRecord record;
+    event_record_init(&record, EVENT_RECORD_COUNTER);
+    record.counts[0] = old_value;
+    record.counts[1] = new_value;
+    event_logger_log_event(logger, &record, counter_get_name(counter), NULL, NULL);
+}
+
+void event_logger_connect_to_counter(EventLogger *self, Counter *counter) {
+    g_signal_connect(counter, "value-changed", G_CALLBACK(on_counter_value_changed), self);
+}
+
+/* Signal handlers for task manager */
+static void on_manager_task_added(TaskManager *manager, gint task_id, const gchar *title, gint priority,
+                                  EventLogger *logger) {
+    EventRecord record;
+    event_record_init(&record, EVENT_RECORD_TASK_ADDED);
+    record.counts[0] = task_id;
+    record.counts[1] = priority;
+    event_logger_log_event(logger, &record, task_manager_get_name(manager), NULL, title);
+}
+
+static void on_manager_task_completed(TaskManager *manager, gint task_id, const gchar *title,
+                                      EventLogger *logger) {
+    EventRecord record;
+    event_record_init(&record, EVENT_RECORD_TASK_COMPLETED);
+    record.counts[0] = task_id;
+    event_logger_log_event(logger, &record, task_manager_get_name(manager), NULL, title);
+}
+
+static void on_manager_task_removed(TaskManager *manager, gint task_id, EventLogger *logger) {
+    EventRecord record;
+    event_record_init(&record, EVENT_RECORD_TASK_REMOVED);
+    record.counts[0] = task_id;
+    event_logger_log_event(logger, &record, task_manager_get_name(manager), NULL, NULL);
+}
+
+static void on_manager_task_ready(TaskManager *manager, gint task_id, const gchar *title,
+                                  EventLogger *logger) {
+    EventRecord record;
+    event_record_init(&record, EVENT_RECORD_TASK_READY);
+    record.counts[0] = task_id;
+    event_logger_log_event(logger, &record, task_manager_get_name(manager), NULL, title);
+}
+
+static void on_manager_task_overdue(TaskManager *manager, gint task_id, const gchar *title, gint64 due_us,
+                                    EventLogger *logger) {
+    EventRecord record;
+    event_record_init(&record, EVENT_RECORD_TASK_OVERDUE);
+    record.counts[0] = task_id;
+    record.amounts[1] = (gdouble)due_us;
+    event_logger_log_event(logger, &record, task_manager_get_name(manager), NULL, title);
+}
+
+void event_logger_connect_to_task_manager(EventLogger *self, TaskManager *manager) {
+    g_signal_connect(manager, "task-added", G_CALLBACK(on_manager_task_added), self);
+    g_signal_connect(manager, "task-completed", G_CALLBACK(on_manager_task_completed), self);
+    g_signal_connect(manager, "task-removed", G_CALLBACK(on_manager_task_removed), self);
+    g_signal_connect(manager, "task-ready", G_CALLBACK(on_manager_task_ready), self);
+    g_signal_connect(manager, "task-overdue", G_CALLBACK(on_manager_task_overdue), self);
+}
+
+/* =============================================================================
+ * Educational Demonstration Functions
+ * ============================================================================= */
+
+void demonstrate_signal_system(void) {
+    printf("\n=== Signal System Demonstration ===\n");
+    printf("Demonstrating Observer pattern with GObject signals\n\n");
+    
+    /* Create bank account and logger */
+    BankAccount *account = bank_account_new("12345-67890", "Alice Johnson", 1000.0);
+    EventLogger *logger = event_logger_new("BankLogger");
+    
+    /* Connect signals */
+    event_logger_connect_to_bank_account(logger, account);
+    
+    printf("Initial balance: $%.2f\n", bank_account_get_balance(account));
+    
+    /* Perform transactions - signals will be emitted */
+    printf("\nPerforming transactions:\n");
+    bank_account_deposit(account, 250.0, "Salary deposit");
+    bank_account_withdraw(account, 75.0, "ATM withdrawal");
+    bank_account_withdraw(account, 1100.0, "Large purchase");  /* Should trigger low balance */
+    
+    /* Cleanup */
+    g_object_unref(account);
     g_object_unref(logger);
 }
 
+static void on_counter_value_notify(GObject *object, GParamSpec *pspec, gpointer user_data) {
+    (void)user_data;
+    printf("Property '%s' changed to %d\n", g_param_spec_get_name(pspec), counter_get_value(COUNTER(object)));
+}
+
 void demonstrate_property_notifications(void) {
     printf("\n=== Property Notification Demonstration ===\n");
     printf("Demonstrating automatic property change notifications\n\n");
@@ -652,7 +2868,7 @@ void demonstrate_property_notifications(void) {
     
     /* Property change listener */
     g_signal_connect(counter, "notify::value", 
-                     G_CALLBACK(g_print), "Property 'value' changed!\n");
+                     G_CALLBACK(on_counter_value_notify), NULL);
     
     printf("Initial counter value: %d\n", counter_get_value(counter));
     
@@ -667,6 +2883,14 @@ void demonstrate_property_notifications(void) {
     
     counter_reset(counter);
     
+    /* A burst inside an update is announced once, from first to last value */
+    printf("\nCoalesced burst of 6 increments:\n");
+    counter_begin_update(counter);
+    for (int i = 0; i < 6; i++) {
+        counter_increment(counter);
+    }
+    counter_end_update(counter);
+    
     g_object_unref(counter);
     g_object_unref(logger);
 }
@@ -684,6 +2908,9 @@ void demonstrate_event_driven_programming(void) {
     event_logger_connect_to_bank_account(central_logger, account1);
     event_logger_connect_to_bank_account(central_logger, account2);
     
+    /* Time the emissions of the first account */
+    bank_account_set_emit_timing(account1, TRUE);
+    
     /* Simulate banking operations */
     printf("Simulating banking operations:\n");
     bank_account_deposit(account1, 200.0, "Direct deposit");
@@ -696,12 +2923,199 @@ void demonstrate_event_driven_programming(void) {
     bank_account_unfreeze(account1);
     bank_account_withdraw(account1, 50.0, "ATM success");  /* Should succeed */
     
+    /* Transfers move money between accounts atomically */
+    printf("\nTransferring between accounts:\n");
+    bank_account_transfer(account2, account1, 250.0, "Rent share");
+    bank_account_transfer(account1, account2, 10000.0, "Too much");  /* Should fail */
+    
+    /* Bulk import: one "batch-applied" signal instead of one signal per operation */
+    printf("\nImporting a batch of transactions:\n");
+    const BankAccountOp import_ops[] = {
+        { BANK_ACCOUNT_OP_DEPOSIT, 120.0 },
+        { BANK_ACCOUNT_OP_WITHDRAW, 900.0 },
+        { BANK_ACCOUNT_OP_WITHDRAW, 5000.0 },  /* Insufficient funds: rejected */
+        { BANK_ACCOUNT_OP_DEPOSIT, 35.5 },
+        { BANK_ACCOUNT_OP_WITHDRAW, 150.0 },   /* Ends below the low balance mark */
+    };
+    bank_account_apply_batch(account2, import_ops, G_N_ELEMENTS(import_ops));
+    
+    /* Nobody watches "notify::balance", so those notifications were skipped */
+    BankAccountEmitStats emit_stats;
+    bank_account_get_emit_stats(account1, &emit_stats);
+    printf("\nAccount %s: %" G_GUINT64_FORMAT " emissions (%" G_GUINT64_FORMAT " ns total, %"
+           G_GUINT64_FORMAT " ns max), %" G_GUINT64_FORMAT " skipped without handlers\n",
+           bank_account_get_account_number(account1), emit_stats.emitted,
+           emit_stats.emit_ns, emit_stats.max_emit_ns, emit_stats.skipped);
+    
+    /* Async logging: handlers only queue a record, a writer thread prints it */
+    printf("\nLogging asynchronously:\n");
+    EventLogger *async_logger = event_logger_new("AsyncBank");
+    event_logger_start_async(async_logger, 1024, 50, EVENT_LOGGER_FULL_BLOCK);
+    event_logger_connect_to_bank_account(async_logger, account2);
+    bank_account_deposit(account2, 400.0, "Refund");
+    bank_account_withdraw(account2, 20.0, "Coffee");
+    event_logger_flush(async_logger);
+    
+    EventLoggerStats log_stats;
+    event_logger_get_stats(async_logger, &log_stats);
+    printf("Async logger: %" G_GUINT64_FORMAT " records in %" G_GUINT64_FORMAT " batches, %"
+           G_GUINT64_FORMAT " dropped\n", log_stats.logged, log_stats.batches, log_stats.dropped);
+    
     /* Cleanup */
     g_object_unref(account1);
     g_object_unref(account2);
+    g_object_unref(async_logger);
     g_object_unref(central_logger);
 }
 
+static void on_task_added(TaskManager *manager, gint task_id, const gchar *title, gint priority,
+                          gpointer user_data) {
+    (void)manager; (void)user_data;
+    printf("Task #%d added: %s (priority %d)\n", task_id, title, priority);
+}
+
+static void on_task_completed(TaskManager *manager, gint task_id, const gchar *title,
+                              gpointer user_data) {
+    (void)user_data;
+    printf("Task #%d completed: %s (%.0f%% done)\n", task_id, title,
+           task_manager_get_completion_percentage(manager));
+}
+
+static void on_task_ready(TaskManager *manager, gint task_id, const gchar *title,
+                          gpointer user_data) {
+    (void)manager; (void)user_data;
+    printf("Task #%d ready: %s\n", task_id, title);
+}
+
+static void on_task_overdue(TaskManager *manager, gint task_id, const gchar *title, gint64 due_us,
+                            gpointer user_data) {
+    gint64 now_us = *(gint64*)user_data;
+    (void)manager;
+    printf("Task #%d overdue: %s (%" G_GINT64_FORMAT " min late)\n", task_id, title,
+           (now_us - due_us) / (60 * G_USEC_PER_SEC));
+}
+
+void demonstrate_task_manager(void) {
+    printf("\n=== Task Manager Demonstration ===\n");
+    printf("Demonstrating an indexed task store with signals\n\n");
+    
+    TaskManager *manager = task_manager_new("Sprint");
+    g_signal_connect(manager, "task-added", G_CALLBACK(on_task_added), NULL);
+    g_signal_connect(manager, "task-completed", G_CALLBACK(on_task_completed), NULL);
+    
+    gint fix_login = task_manager_add_task(manager, "Fix login bug", "Users cannot log in", 1);
+    task_manager_add_task(manager, "Write release notes", "Version 1.1", 2);
+    gint update_deps = task_manager_add_task(manager, "Update dependencies", NULL, 3);
+    task_manager_add_task(manager, "Review pull requests", "Three open", 1);
+    
+    printf("\n");
+    task_manager_complete_task(manager, fix_login);
+    task_manager_complete_task(manager, update_deps);
+    task_manager_complete_task(manager, fix_login);  /* Already completed: no signal */
+    
+    /* Queries walk only the lists they need: O(k) in the tasks returned */
+    GPtrArray *pending = task_manager_get_pending_tasks(manager);
+    printf("\nPending tasks:\n");
+    for (guint i = 0; i < pending->len; i++) {
+        SignalTask *task = g_ptr_array_index(pending, i);
+        printf("  #%d [P%d] %s\n", task->id, signal_task_get_priority(task), task->title);
+    }
+    g_ptr_array_unref(pending);
+    
+    printf("Completed %d of %d tasks\n", task_manager_get_completed_count(manager),
+           task_manager_get_total_tasks(manager));
+    
+    /* Deferred starts and deadlines sit in a timer wheel until processed */
+    printf("\nScheduling:\n");
+    const gint64 minute = 60 * G_USEC_PER_SEC;
+    gint64 now_us = g_get_real_time();
+    g_signal_connect(manager, "task-ready", G_CALLBACK(on_task_ready), NULL);
+    g_signal_connect(manager, "task-overdue", G_CALLBACK(on_task_overdue), &now_us);
+    
+    gint backup = task_manager_add_deferred_task(manager, "Nightly backup", NULL, 2, now_us + 30 * minute);
+    task_manager_set_task_deadline(manager, backup, now_us + 45 * minute);
+    gint notes = task_manager_add_task(manager, "Publish meeting notes", NULL, 3);
+    task_manager_set_task_deadline(manager, notes, now_us + 20 * minute);
+    gint report = task_manager_add_task(manager, "Send weekly report", NULL, 2);
+    task_manager_set_task_deadline(manager, report, now_us + 10 * minute);
+    task_manager_complete_task(manager, report);  /* Deadline cancelled */
+    
+    /* Pretend an hour passes; everything due in it is handled in one batch */
+    now_us += 60 * minute;
+    guint fired = task_manager_process_timers(manager, now_us);
+    printf("%u timers fired; next timer: %s\n", fired,
+           task_manager_get_next_timer_us(manager) < 0 ? "none" : "pending");
+    
+    g_object_unref(manager);
+}
+
+static void on_atomic_counter_changed(AtomicCounter *counter, gint64 old_value, gint64 new_value,
+                                      gpointer user_data) {
+    (void)user_data;
+    printf("%s: %" G_GINT64_FORMAT " -> %" G_GINT64_FORMAT "\n",
+           atomic_counter_get_name(counter), old_value, new_value);
+}
+
+static void on_atomic_counter_limit(AtomicCounter *counter, gint64 limit, gboolean is_maximum,
+                                    gpointer user_data) {
+    (void)user_data;
+    printf("%s: hit %s of %" G_GINT64_FORMAT "\n", atomic_counter_get_name(counter),
+           is_maximum ? "maximum" : "minimum", limit);
+}
+
+#define ATOMIC_COUNTER_DEMO_THREADS 4
+
+typedef struct {
+    AtomicCounter *tickets;
+    AtomicCounter *requests;
+    guint sold;
+} AtomicCounterDemoWorker;
+
+static gpointer atomic_counter_demo_worker(gpointer data) {
+    AtomicCounterDemoWorker *worker = data;
+    for (int i = 0; i < 100000; i++) {
+        atomic_counter_increment(worker->requests);
+        if (i < 300 && atomic_counter_increment(worker->tickets)) {
+            worker->sold++;
+        }
+    }
+    return NULL;
+}
+
+void demonstrate_atomic_counter(void) {
+    printf("\n=== Atomic Counter Demonstration ===\n");
+    printf("Demonstrating counters updated from several threads\n\n");
+    
+    /* Signals are emitted on this thread's main context, not by the workers */
+    AtomicCounter *tickets = atomic_counter_new("Tickets", 0, 0, 1000, 1);
+    AtomicCounter *requests = atomic_counter_new_sharded("Requests", 1);
+    g_signal_connect(tickets, "value-changed", G_CALLBACK(on_atomic_counter_changed), NULL);
+    g_signal_connect(tickets, "limit-reached", G_CALLBACK(on_atomic_counter_limit), NULL);
+    g_signal_connect(requests, "value-changed", G_CALLBACK(on_atomic_counter_changed), NULL);
+    
+    GThread *threads[ATOMIC_COUNTER_DEMO_THREADS];
+    AtomicCounterDemoWorker workers[ATOMIC_COUNTER_DEMO_THREADS];
+    for (int i = 0; i < ATOMIC_COUNTER_DEMO_THREADS; i++) {
+        workers[i] = (AtomicCounterDemoWorker){ tickets, requests, 0 };
+        threads[i] = g_thread_new("counter-worker", atomic_counter_demo_worker, &workers[i]);
+    }
+    guint sold = 0;
+    for (int i = 0; i < ATOMIC_COUNTER_DEMO_THREADS; i++) {
+        g_thread_join(threads[i]);
+        sold += workers[i].sold;
+    }
+    printf("%d threads sold %u tickets (at most 1000) and counted %" G_GINT64_FORMAT " requests\n",
+           ATOMIC_COUNTER_DEMO_THREADS, sold, atomic_counter_get_value(requests));
+    
+    /* Deliver everything that happened as one batch of signals */
+    printf("\nDispatching signals:\n");
+    while (g_main_context_iteration(NULL, FALSE)) {
+    }
+    
+    g_object_unref(requests);
+    g_object_unref(tickets);
+}
+
 void test_signals_properties(void) {
     printf("\n=== GObject Signals and Properties Educational Demonstration ===\n");
     printf("Learning Objectives:\n");
@@ -714,6 +3128,8 @@ void test_signals_properties(void) {
     demonstrate_signal_system();
     demonstrate_property_notifications();
     demonstrate_event_driven_programming();
+    demonstrate_task_manager();
+    demonstrate_atomic_counter();
     
     printf("\nSignals and Properties demonstration completed!\n");
 }
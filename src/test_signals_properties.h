@@ -2,6 +2,7 @@
 #define TEST_SIGNALS_PROPERTIES_H
 
 #include <glib-object.h>
+#include <stdio.h>
 
 G_BEGIN_DECLS
 
@@ -52,21 +53,83 @@ G_DECLARE_FINAL_TYPE(BankAccount, bank_account, , BANK_ACCOUNT, GObject)
 /* BankAccount public API */
 BankAccount* bank_account_new(const gchar *account_number, const gchar *owner_name, gdouble initial_balance);
 
-/* Transaction methods that emit signals */
+/* Balances are kept as integer minor units (cents), so repeated deposits
+ * and withdrawals never accumulate rounding error */
+#define BANK_ACCOUNT_CENTS_PER_UNIT 100
+
+/* Largest magnitude the gdouble API accepts for amounts, balances and
+ * credit limits; anything larger, infinite or NaN is rejected. It keeps
+ * every amount exact to the cent in a gdouble and leaves the gint64 cent
+ * balance plenty of headroom. */
+#define BANK_ACCOUNT_MAX_AMOUNT 1e13
+
+/* Transaction methods that emit signals. Accounts are thread-safe:
+ * deposits and withdrawals update the balance with atomic operations and
+ * take no lock, while bank_account_transfer() holds both accounts' locks
+ * (taken in a fixed order) while it moves the money, then emits
+ * "transfer-out" on from and "transfer-in" on to. A deposit or withdrawal
+ * racing with bank_account_freeze() may still complete. */
+gboolean bank_account_deposit_cents(BankAccount *self, gint64 cents, const gchar *description);
+gboolean bank_account_withdraw_cents(BankAccount *self, gint64 cents, const gchar *description);
+gboolean bank_account_transfer_cents(BankAccount *from, BankAccount *to, gint64 cents, const gchar *description);
+
+/* Convenience wrappers taking amounts in currency units, rounded to the
+ * nearest cent; amounts that round to zero are rejected */
 gboolean bank_account_deposit(BankAccount *self, gdouble amount, const gchar *description);
 gboolean bank_account_withdraw(BankAccount *self, gdouble amount, const gchar *description);
 gboolean bank_account_transfer(BankAccount *from, BankAccount *to, gdouble amount, const gchar *description);
 
+/**
+ * One operation of a transaction batch
+ */
+typedef enum {
+    BANK_ACCOUNT_OP_DEPOSIT,
+    BANK_ACCOUNT_OP_WITHDRAW
+} BankAccountOpKind;
+
+typedef struct {
+    BankAccountOpKind kind;
+    gdouble amount;
+} BankAccountOp;
+
+/**
+ * Apply ops in order with the same rules as deposit/withdraw (amounts are
+ * rounded to the nearest cent), skipping operations that would be denied.
+ * Instead of per-operation signals, emits one "batch-applied" signal with
+ * the totals, at most one balance notification, and checks for a low
+ * balance once at the end.
+ * Returns the number of operations applied (0 if the account is frozen).
+ */
+guint bank_account_apply_batch(BankAccount *self, const BankAccountOp *ops, gsize n_ops);
+
 /* Account management */
 void bank_account_freeze(BankAccount *self);
 void bank_account_unfreeze(BankAccount *self);
 void bank_account_set_credit_limit(BankAccount *self, gdouble limit);
 
 /* Property accessors */
+gint64 bank_account_get_balance_cents(BankAccount *self);
 gdouble bank_account_get_balance(BankAccount *self);
 const gchar* bank_account_get_account_number(BankAccount *self);
 gboolean bank_account_is_frozen(BankAccount *self);
 
+/**
+ * Signal emission counters of one account. Signals and property
+ * notifications are only emitted while a handler is connected; emissions
+ * skipped for lack of handlers are counted separately.
+ */
+typedef struct {
+    guint64 emitted;        /* signals and notifications delivered to handlers */
+    guint64 skipped;        /* emissions skipped because nothing was connected */
+    guint64 emit_ns;        /* time spent emitting, while timing is enabled */
+    guint64 max_emit_ns;
+} BankAccountEmitStats;
+
+/* Emission instrumentation (timing is off by default) */
+void bank_account_set_emit_timing(BankAccount *self, gboolean enabled);
+void bank_account_get_emit_stats(BankAccount *self, BankAccountEmitStats *stats);
+void bank_account_reset_emit_stats(BankAccount *self);
+
 /* =============================================================================
  * Counter Class - Demonstrates property change notifications
  * ============================================================================= */
@@ -85,10 +148,70 @@ gboolean counter_decrement(Counter *self);
 gboolean counter_set_value(Counter *self, gint value);
 void counter_reset(Counter *self);
 
+/* Coalesced notification. Between begin_update and the matching
+ * end_update (calls nest) value changes are not announced; end_update
+ * emits a single "value-changed" from the value before the first change
+ * to the current one, plus one notify::value, or nothing if several
+ * changes ended where they started. A single change is always announced,
+ * even one that sets the current value. flush delivers a pending change at
+ * once, even inside an update. "limit-reached" and "reset" are never
+ * deferred. */
+void counter_begin_update(Counter *self);
+void counter_end_update(Counter *self);
+void counter_flush(Counter *self);
+
+/* Rate-limited delivery ("notify-interval" property, 0 = off). Changes
+ * outside an update are announced at most once per interval_ms: the first
+ * change after a quiet period is announced immediately, later ones are
+ * collected and delivered by a timeout on the thread-default main context. */
+void counter_set_notify_interval(Counter *self, guint interval_ms);
+guint counter_get_notify_interval(Counter *self);
+
 /* Property accessors */
 gint counter_get_value(Counter *self);
 const gchar* counter_get_name(Counter *self);
 
+/* =============================================================================
+ * AtomicCounter Class - Counter shared between threads
+ * ============================================================================= */
+
+#define TYPE_ATOMIC_COUNTER (atomic_counter_get_type())
+#define ATOMIC_COUNTER(obj) (G_TYPE_CHECK_INSTANCE_CAST((obj), TYPE_ATOMIC_COUNTER, AtomicCounter))
+#define IS_ATOMIC_COUNTER(obj) (G_TYPE_CHECK_INSTANCE_TYPE((obj), TYPE_ATOMIC_COUNTER))
+G_DECLARE_FINAL_TYPE(AtomicCounter, atomic_counter, , ATOMIC_COUNTER, GObject)
+
+/**
+ * Counter that any thread may update without locks.
+ *
+ * A bounded counter keeps its value in one atomic word; increment and
+ * decrement honor minimum, maximum and step with a compare-and-swap loop.
+ * A sharded counter adds to one cache-line-sized slot per CPU and sums
+ * the slots on read. It has no bounds, and set_value/reset are not atomic
+ * with respect to concurrent increments; use it for write-heavy statistics.
+ *
+ * Signals are never emitted by the updating thread. An update wakes a
+ * source on the "context" main context (by default the one that was
+ * thread-default when the counter was created). When that context runs,
+ * the counter emits one "value-changed" from the last announced value if
+ * it differs, "limit-reached" once for each bound hit since, and "reset"
+ * if it was reset, all on the thread iterating the context. The pending
+ * source does not keep the counter alive, so the last reference may be
+ * dropped on any thread; updates made just before are then not announced.
+ */
+AtomicCounter* atomic_counter_new(const gchar *name, gint64 initial_value, gint64 min, gint64 max, gint64 step);
+AtomicCounter* atomic_counter_new_sharded(const gchar *name, gint64 step);
+
+/* AtomicCounter operations; safe from any thread */
+gboolean atomic_counter_increment(AtomicCounter *self);
+gboolean atomic_counter_decrement(AtomicCounter *self);
+gboolean atomic_counter_set_value(AtomicCounter *self, gint64 value);
+void atomic_counter_reset(AtomicCounter *self);
+
+/* Property accessors */
+gint64 atomic_counter_get_value(AtomicCounter *self);
+const gchar* atomic_counter_get_name(AtomicCounter *self);
+gboolean atomic_counter_is_sharded(AtomicCounter *self);
+
 /* =============================================================================
  * TaskManager Class - Demonstrates complex signal patterns
  * ============================================================================= */
@@ -99,32 +222,94 @@ const gchar* counter_get_name(Counter *self);
 G_DECLARE_FINAL_TYPE(TaskManager, task_manager, , TASK_MANAGER, GObject)
 
 /**
- * SignalTask structure for the task manager (renamed to avoid conflicts)
+ * SignalTask structure for the task manager (renamed to avoid conflicts).
+ *
+ * Kept compact for stores of millions of tasks: timestamps are plain
+ * microseconds since the Unix epoch, title and description are interned
+ * GRefStrings (identical strings are stored once), and priority and
+ * completion share one flags byte. Read them through the accessors below.
  */
+#define SIGNAL_TASK_PRIORITY_MASK 0x03  /* 1 = high, 2 = medium, 3 = low */
+#define SIGNAL_TASK_COMPLETED     0x04
+#define SIGNAL_TASK_DEFERRED      0x08  /* waiting for its start time */
+#define SIGNAL_TASK_OVERDUE       0x10  /* deadline passed before completion */
+
 typedef struct {
     gint id;
-    gchar *title;
-    gchar *description;
-    gint priority;  /* 1 = high, 2 = medium, 3 = low */
-    gboolean completed;
-    GDateTime *created_at;
-    GDateTime *completed_at;
+    guint8 flags;
+    const gchar *title;         /* interned GRefString */
+    const gchar *description;   /* interned GRefString, or NULL */
+    gint64 created_us;          /* g_get_real_time() */
+    gint64 completed_us;        /* 0 while pending */
 } SignalTask;
 
 /* SignalTask helper functions */
 SignalTask* signal_task_new(gint id, const gchar *title, const gchar *description, gint priority);
 void signal_task_free(SignalTask *task);
 
-/* TaskManager public API */
+static inline gint signal_task_get_priority(const SignalTask *task) {
+    return task->flags & SIGNAL_TASK_PRIORITY_MASK;
+}
+
+static inline gboolean signal_task_is_completed(const SignalTask *task) {
+    return (task->flags & SIGNAL_TASK_COMPLETED) != 0;
+}
+
+static inline gboolean signal_task_is_deferred(const SignalTask *task) {
+    return (task->flags & SIGNAL_TASK_DEFERRED) != 0;
+}
+
+static inline gboolean signal_task_is_overdue(const SignalTask *task) {
+    return (task->flags & SIGNAL_TASK_OVERDUE) != 0;
+}
+
+/**
+ * Timestamps as local GDateTimes, created on each call; free with
+ * g_date_time_unref(). get_completed_at returns NULL while pending.
+ */
+GDateTime* signal_task_get_created_at(const SignalTask *task);
+GDateTime* signal_task_get_completed_at(const SignalTask *task);
+
+/* TaskManager public API. Tasks are indexed by id in a hash table and
+ * linked into one list per (priority, completed) pair, so lookups and
+ * updates are O(1), queries are O(k) in the number of tasks returned and
+ * the statistics are maintained counters. Not thread-safe.
+ * Emits "task-added", "task-completed", "task-removed", "task-ready"
+ * and "task-overdue". */
 TaskManager* task_manager_new(const gchar *name);
+const gchar* task_manager_get_name(TaskManager *self);
 
-/* Task operations */
+/* Task operations. add_task returns the new task's id (ids start at 1),
+ * or -1 if priority is not 1-3. Tasks are owned by the manager. */
 gint task_manager_add_task(TaskManager *self, const gchar *title, const gchar *description, gint priority);
 gboolean task_manager_complete_task(TaskManager *self, gint task_id);
 gboolean task_manager_remove_task(TaskManager *self, gint task_id);
 SignalTask* task_manager_get_task(TaskManager *self, gint task_id);
 
-/* Task queries */
+/* Scheduling. Start times and deadlines are g_get_real_time() microseconds
+ * and are kept in a hierarchical timer wheel with millisecond ticks, so
+ * arming and cancelling a timer is O(1) however many are pending.
+ *
+ * add_deferred_task adds a task that stays out of the pending lists until
+ * start_us; it then joins them and "task-ready" is emitted. A deadline that
+ * passes before the task is completed marks it overdue and emits
+ * "task-overdue". Pass due_us = 0 to clear a deadline.
+ *
+ * Timers fire only from process_timers, which handles everything due up
+ * to now_us in one batch and returns the number of timers fired. Call it
+ * from a timeout source; get_next_timer_us tells when there is next work
+ * to do (-1 if none), and no timer fires before it. */
+gint task_manager_add_deferred_task(TaskManager *self, const gchar *title, const gchar *description,
+                                    gint priority, gint64 start_us);
+gboolean task_manager_set_task_deadline(TaskManager *self, gint task_id, gint64 due_us);
+gint64 task_manager_get_task_deadline(TaskManager *self, gint task_id);
+guint task_manager_process_timers(TaskManager *self, gint64 now_us);
+gint64 task_manager_get_next_timer_us(TaskManager *self);
+
+/* Task queries. Results are ordered by priority, then by insertion order
+ * (completion order for completed tasks); get_tasks_by_priority lists
+ * pending tasks first. Free the array with g_ptr_array_unref(); the tasks
+ * stay owned by the manager. */
 GPtrArray* task_manager_get_tasks_by_priority(TaskManager *self, gint priority);
 GPtrArray* task_manager_get_pending_tasks(TaskManager *self);
 GPtrArray* task_manager_get_completed_tasks(TaskManager *self);
@@ -151,6 +336,108 @@ void event_logger_connect_to_bank_account(EventLogger *self, BankAccount *accoun
 void event_logger_connect_to_counter(EventLogger *self, Counter *counter);
 void event_logger_connect_to_task_manager(EventLogger *self, TaskManager *manager);
 
+/**
+ * Write events to the file at path (appending) instead of stdout.
+ * Returns FALSE if the file cannot be opened; not allowed in async mode.
+ */
+gboolean event_logger_set_log_file(EventLogger *self, const gchar *path);
+
+/**
+ * Write events as binary records to append-only segments in directory
+ * (see event_log.h) instead of as text. If a write fails, the binary log
+ * is closed with a warning and logging falls back to text. Not allowed in
+ * async mode.
+ */
+gboolean event_logger_set_binary_log(EventLogger *self, const gchar *directory,
+                                     guint64 segment_bytes, GError **error);
+
+/**
+ * Compact binary form of one logged event, also used as the on-disk record
+ * of the binary event log (event_log.h) and queued in async mode. Strings
+ * are copied into the record so that it stays valid after the emitting
+ * object is gone, keeping at most EVENT_RECORD_NAME_LEN - 1 bytes of names
+ * and EVENT_RECORD_TEXT_LEN - 1 bytes of descriptions; longer strings are
+ * cut at a UTF-8 character boundary. Synchronous text output does not go
+ * through a record and prints strings in full.
+ * The layout has no padding; new fields may only be added at the end.
+ */
+typedef enum {
+    EVENT_RECORD_DEPOSIT,
+    EVENT_RECORD_WITHDRAWAL,
+    EVENT_RECORD_TRANSFER_OUT,
+    EVENT_RECORD_TRANSFER_IN,
+    EVENT_RECORD_BATCH,
+    EVENT_RECORD_LOW_BALANCE,
+    EVENT_RECORD_COUNTER,
+    EVENT_RECORD_TASK_ADDED,
+    EVENT_RECORD_TASK_COMPLETED,
+    EVENT_RECORD_TASK_REMOVED,
+    EVENT_RECORD_TASK_READY,
+    EVENT_RECORD_TASK_OVERDUE
+} EventRecordKind;
+
+#define EVENT_RECORD_NAME_LEN 24
+#define EVENT_RECORD_TEXT_LEN 48
+
+typedef struct {
+    gint64 timestamp_us;                    /* g_get_real_time() at emission */
+    gdouble amounts[3];                     /* amount or deposited/withdrawn, then new balance;
+                                               a task's deadline (microseconds) in [1] */
+    guint32 kind;                           /* EventRecordKind */
+    gint32 counts[2];                       /* batch applied/rejected, counter old/new value,
+                                               task id/priority */
+    guint32 reserved;                       /* zero */
+    gchar source[EVENT_RECORD_NAME_LEN];    /* account number, counter or task manager name */
+    gchar peer[EVENT_RECORD_NAME_LEN];      /* transfer counterparty */
+    gchar text[EVENT_RECORD_TEXT_LEN];      /* description or task title */
+} EventRecord;
+
+/**
+ * Print a record as one line of the text log, prefixed with [log_name]
+ */
+void event_record_print(const EventRecord *record, const gchar *log_name, FILE *out);
+
+/**
+ * What a handler does when its thread's ring is full in async mode
+ */
+typedef enum {
+    EVENT_LOGGER_FULL_DROP,     /* discard the event and count it */
+    EVENT_LOGGER_FULL_BLOCK     /* wait for the writer thread to make room */
+} EventLoggerFullPolicy;
+
+typedef struct {
+    guint64 logged;             /* records written to the log file */
+    guint64 dropped;            /* records discarded by EVENT_LOGGER_FULL_DROP */
+    guint64 blocked;            /* handlers that had to wait for room */
+    guint64 batches;            /* writer wake-ups that wrote and flushed records */
+} EventLoggerStats;
+
+/**
+ * Switch to asynchronous logging. Handlers then only copy an EventRecord
+ * into a lock-free ring owned by the emitting thread (ring_capacity records,
+ * rounded up to a power of two); a writer thread formats the records and
+ * flushes the file in batches, at least every flush_interval_ms and sooner
+ * when a ring is half full. Records from one thread are written in order;
+ * records from different threads may interleave.
+ */
+gboolean event_logger_start_async(EventLogger *self, guint ring_capacity, guint flush_interval_ms,
+                                  EventLoggerFullPolicy policy);
+
+/**
+ * Wait until every record logged so far has been written and flushed
+ */
+void event_logger_flush(EventLogger *self);
+
+/**
+ * Return to synchronous logging, write the remaining records and stop the
+ * writer thread. Handlers may keep running on other threads: events logged
+ * from then on are written synchronously, and handlers already queueing or
+ * waiting for room finish first. Also done by finalize.
+ */
+void event_logger_stop_async(EventLogger *self);
+
+void event_logger_get_stats(EventLogger *self, EventLoggerStats *stats);
+
 /**
  * Notifier class - provides user notifications
  */
@@ -187,6 +474,12 @@ void demonstrate_interfaces(void);
  */
 void demonstrate_event_driven_programming(void);
 
+/**
+ * Shows the indexed TaskManager and its signals
+ */
+void demonstrate_task_manager(void);
+void demonstrate_atomic_counter(void);
+
 /**
  * Main demonstration function
  */
@@ -0,0 +1,226 @@
+#include "timer_wheel.h"
+
+#define TIMER_WHEEL_SLOT_MASK (TIMER_WHEEL_SLOTS - 1)
+/* Ticks covered by the whole wheel; later expiries wait at its far edge */
+#define TIMER_WHEEL_SPAN (G_GUINT64_CONSTANT(1) << (TIMER_WHEEL_LEVELS * TIMER_WHEEL_SLOT_BITS))
+/* Slot of entries taken out of their slot while it expires */
+#define TIMER_WHEEL_DETACHED G_MAXUINT32
+
+G_STATIC_ASSERT(TIMER_WHEEL_SLOTS == 64);   /* one guint64 occupancy bitmap per level */
+
+struct _TimerWheel {
+    guint64 current;                                        /* first unprocessed tick */
+    gsize n_timers;
+    guint64 occupied[TIMER_WHEEL_LEVELS];                   /* bit i: slot i is non-empty */
+    TimerWheelEntry *slots[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];
+};
+
+static inline guint level_shift(guint level) {
+    return level * TIMER_WHEEL_SLOT_BITS;
+}
+
+static inline guint count_trailing_zeros(guint64 bits) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (guint)__builtin_ctzll(bits);
+#else
+    guint n = 0;
+    while (!(bits & 1)) {
+        bits >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+TimerWheel* timer_wheel_new(guint64 now) {
+    TimerWheel *wheel = g_new0(TimerWheel, 1);
+    wheel->current = now;
+    return wheel;
+}
+
+void timer_wheel_free(TimerWheel *wheel) {
+    g_free(wheel);
+}
+
+/* Place entry in the coarsest level whose slot still separates its expiry
+ * from the current tick */
+static void timer_wheel_link(TimerWheel *wheel, TimerWheelEntry *entry) {
+    guint64 delta = entry->expires > wheel->current ? entry->expires - wheel->current : 0;
+    delta = MIN(delta, TIMER_WHEEL_SPAN - 1);
+
+    guint level = 0;
+    while (delta >> level_shift(level + 1)) {
+        level++;
+    }
+    guint index = ((wheel->current + delta) >> level_shift(level)) & TIMER_WHEEL_SLOT_MASK;
+
+    TimerWheelEntry **head = &wheel->slots[level][index];
+    entry->next = *head;
+    if (*head) {
+        (*head)->pprev = &entry->next;
+    }
+    *head = entry;
+    entry->pprev = head;
+    entry->slot = level * TIMER_WHEEL_SLOTS + index;
+
+    wheel->occupied[level] |= G_GUINT64_CONSTANT(1) << index;
+    wheel->n_timers++;
+}
+
+static void timer_wheel_unlink(TimerWheel *wheel, TimerWheelEntry *entry) {
+    *entry->pprev = entry->next;
+    if (entry->next) {
+        entry->next->pprev = entry->pprev;
+    }
+    if (entry->slot != TIMER_WHEEL_DETACHED) {
+        guint level = entry->slot / TIMER_WHEEL_SLOTS;
+        guint index = entry->slot % TIMER_WHEEL_SLOTS;
+        if (!wheel->slots[level][index]) {
+            wheel->occupied[level] &= ~(G_GUINT64_CONSTANT(1) << index);
+        }
+    }
+    entry->next = NULL;
+    entry->pprev = NULL;
+    wheel->n_timers--;
+}
+
+static TimerWheelEntry* timer_wheel_take_slot(TimerWheel *wheel, guint level, guint index) {
+    TimerWheelEntry *list = wheel->slots[level][index];
+    wheel->slots[level][index] = NULL;
+    wheel->occupied[level] &= ~(G_GUINT64_CONSTANT(1) << index);
+    return list;
+}
+
+void timer_wheel_schedule(TimerWheel *wheel, TimerWheelEntry *entry, guint64 expires) {
+    g_return_if_fail(wheel != NULL);
+    g_return_if_fail(entry != NULL);
+
+    if (timer_wheel_entry_is_scheduled(entry)) {
+        timer_wheel_unlink(wheel, entry);
+    }
+    entry->expires = expires;
+    timer_wheel_link(wheel, entry);
+}
+
+gboolean timer_wheel_cancel(TimerWheel *wheel, TimerWheelEntry *entry) {
+    g_return_val_if_fail(wheel != NULL, FALSE);
+    g_return_val_if_fail(entry != NULL, FALSE);
+
+    if (!timer_wheel_entry_is_scheduled(entry)) {
+        return FALSE;
+    }
+    timer_wheel_unlink(wheel, entry);
+    return TRUE;
+}
+
+/* First tick >= from at which a level-0 slot expires or a coarser slot is
+ * due to move down. For a coarser level, the slot under from's index only
+ * moves at from itself if from starts that slot; otherwise it comes round
+ * again a full rotation later. */
+static guint64 timer_wheel_next_tick_from(TimerWheel *wheel, guint64 from) {
+    guint64 next = G_MAXUINT64;
+
+    for (guint level = 0; level < TIMER_WHEEL_LEVELS; level++) {
+        guint64 occupied = wheel->occupied[level];
+        if (!occupied) {
+            continue;
+        }
+
+        guint shift = level_shift(level);
+        guint index = (from >> shift) & TIMER_WHEEL_SLOT_MASK;
+        guint64 rotated = index ? (occupied >> index) | (occupied << (TIMER_WHEEL_SLOTS - index)) : occupied;
+        gboolean slot_starts = (from & ((G_GUINT64_CONSTANT(1) << shift) - 1)) == 0;
+        if (!slot_starts) {
+            rotated &= ~G_GUINT64_CONSTANT(1);
+        }
+        guint distance = rotated ? count_trailing_zeros(rotated) : TIMER_WHEEL_SLOTS;
+
+        guint64 tick = ((from >> shift) + distance) << shift;
+        next = MIN(next, tick);
+    }
+    return next;
+}
+
+/* Move the timers of every coarser slot that starts at the current tick
+ * down to finer levels */
+static void timer_wheel_cascade(TimerWheel *wheel) {
+    for (guint level = 1; level < TIMER_WHEEL_LEVELS; level++) {
+        guint shift = level_shift(level);
+        if (wheel->current & ((G_GUINT64_CONSTANT(1) << shift) - 1)) {
+            break;
+        }
+
+        guint index = (wheel->current >> shift) & TIMER_WHEEL_SLOT_MASK;
+        TimerWheelEntry *entry = timer_wheel_take_slot(wheel, level, index);
+        while (entry) {
+            TimerWheelEntry *next = entry->next;
+            wheel->n_timers--;
+            timer_wheel_link(wheel, entry);
+            entry = next;
+        }
+    }
+}
+
+/* Expire the level-0 slot of the current tick and move past it. The slot
+ * is detached first so callbacks can schedule or cancel any timer. */
+static guint timer_wheel_expire_current(TimerWheel *wheel, TimerWheelExpireFunc func, gpointer user_data) {
+    guint64 tick = wheel->current;
+    TimerWheelEntry *pending = timer_wheel_take_slot(wheel, 0, tick & TIMER_WHEEL_SLOT_MASK);
+    if (pending) {
+        pending->pprev = &pending;
+    }
+    for (TimerWheelEntry *entry = pending; entry; entry = entry->next) {
+        entry->slot = TIMER_WHEEL_DETACHED;
+    }
+    wheel->current = tick + 1;
+
+    guint expired = 0;
+    while (pending) {
+        TimerWheelEntry *entry = pending;
+        timer_wheel_unlink(wheel, entry);
+
+        if (entry->expires > tick) {
+            // Was beyond the wheel's span when placed
+            timer_wheel_link(wheel, entry);
+            continue;
+        }
+        func(entry, user_data);
+        expired++;
+    }
+    return expired;
+}
+
+guint timer_wheel_advance(TimerWheel *wheel, guint64 now, TimerWheelExpireFunc func, gpointer user_data) {
+    g_return_val_if_fail(wheel != NULL, 0);
+    g_return_val_if_fail(func != NULL, 0);
+    g_return_val_if_fail(now < G_MAXUINT64, 0);
+
+    guint expired = 0;
+    while (wheel->current <= now) {
+        // Jump over ticks where nothing expires or moves
+        guint64 tick = timer_wheel_next_tick_from(wheel, wheel->current);
+        if (tick > now) {
+            wheel->current = now + 1;
+            break;
+        }
+        wheel->current = tick;
+        timer_wheel_cascade(wheel);
+        expired += timer_wheel_expire_current(wheel, func, user_data);
+    }
+    return expired;
+}
+
+guint64 timer_wheel_get_next_tick(TimerWheel *wheel) {
+    g_return_val_if_fail(wheel != NULL, G_MAXUINT64);
+    return timer_wheel_next_tick_from(wheel, wheel->current);
+}
+
+guint64 timer_wheel_get_current(TimerWheel *wheel) {
+    g_return_val_if_fail(wheel != NULL, 0);
+    return wheel->current;
+}
+
+gsize timer_wheel_get_n_timers(TimerWheel *wheel) {
+    g_return_val_if_fail(wheel != NULL, 0);
+    return wheel->n_timers;
+}
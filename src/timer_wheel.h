@@ -0,0 +1,99 @@
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <glib.h>
+
+/**
+ * Hierarchical timing wheel for large numbers of timers.
+ *
+ * Time is measured in ticks whose length the caller chooses. The wheel has
+ * TIMER_WHEEL_LEVELS levels of 64 slots; level n covers 64^(n+1) ticks, so
+ * a timer lands in the coarsest slot that still tells it apart from "now"
+ * and moves to finer levels as its expiry approaches. Timers further away
+ * than the whole wheel (64^6 ticks) wait in the top level and are placed
+ * again until they come into range.
+ *
+ * Timers are intrusive: embed a TimerWheelEntry in your own record and
+ * recover the record in the expiry callback with G_STRUCT_MEMBER_P or a
+ * container_of-style cast. Scheduling and cancelling unlink and link one
+ * list node and never allocate, so both are O(1).
+ *
+ * timer_wheel_advance() processes ticks in one batch. Per-level occupancy
+ * bitmaps let it jump straight to the next occupied slot, so its cost
+ * depends on the number of timers that expire or move, not on the number
+ * of ticks skipped.
+ *
+ * A wheel is not thread-safe.
+ */
+#define TIMER_WHEEL_LEVELS 6
+#define TIMER_WHEEL_SLOT_BITS 6
+#define TIMER_WHEEL_SLOTS (1 << TIMER_WHEEL_SLOT_BITS)
+
+typedef struct _TimerWheel TimerWheel;
+typedef struct _TimerWheelEntry TimerWheelEntry;
+
+struct _TimerWheelEntry {
+    TimerWheelEntry *next;
+    TimerWheelEntry **pprev;    /* NULL while not scheduled */
+    guint64 expires;            /* tick at which the timer fires */
+    guint32 slot;               /* level * TIMER_WHEEL_SLOTS + index */
+};
+
+/**
+ * Called for each expired timer. The entry is already unscheduled, so the
+ * callback may schedule it again, cancel other timers or free it.
+ */
+typedef void (*TimerWheelExpireFunc)(TimerWheelEntry *entry, gpointer user_data);
+
+/**
+ * Create a wheel whose clock starts at now (in ticks)
+ */
+TimerWheel* timer_wheel_new(guint64 now);
+
+/**
+ * Free the wheel. Scheduled entries are not touched and must not be
+ * cancelled afterwards.
+ */
+void timer_wheel_free(TimerWheel *wheel);
+
+static inline void timer_wheel_entry_init(TimerWheelEntry *entry) {
+    entry->next = NULL;
+    entry->pprev = NULL;
+}
+
+static inline gboolean timer_wheel_entry_is_scheduled(const TimerWheelEntry *entry) {
+    return entry->pprev != NULL;
+}
+
+/**
+ * Schedule entry to fire at tick expires, moving it if it is already
+ * scheduled. Expiry ticks that have already been processed fire on the
+ * next advance.
+ */
+void timer_wheel_schedule(TimerWheel *wheel, TimerWheelEntry *entry, guint64 expires);
+
+/**
+ * Unschedule entry; FALSE if it was not scheduled
+ */
+gboolean timer_wheel_cancel(TimerWheel *wheel, TimerWheelEntry *entry);
+
+/**
+ * Process every tick up to and including now, calling func for each timer
+ * that expires, tick by tick. Returns the number of expired timers.
+ */
+guint timer_wheel_advance(TimerWheel *wheel, guint64 now, TimerWheelExpireFunc func, gpointer user_data);
+
+/**
+ * Earliest tick at which advancing has work to do (a timer expires or
+ * moves to a finer level), or G_MAXUINT64 if no timer is scheduled. No
+ * timer expires before it, so it is a safe time to sleep until.
+ */
+guint64 timer_wheel_get_next_tick(TimerWheel *wheel);
+
+/**
+ * First tick not processed yet
+ */
+guint64 timer_wheel_get_current(TimerWheel *wheel);
+gsize timer_wheel_get_n_timers(TimerWheel *wheel);
+
+#endif /* TIMER_WHEEL_H */
@@ -0,0 +1,113 @@
+#include <glib.h>
+#include <glib-object.h>
+
+#include "test_signals_properties.h"
+
+/* =============================================================================
+ * Regression tests for Counter value-changed / notify::value delivery
+ * ============================================================================= */
+
+typedef struct {
+    guint n_changed;
+    guint n_notified;
+    gint last_old;
+    gint last_new;
+} Emissions;
+
+static void on_value_changed(Counter *counter, gint old_value, gint new_value, Emissions *emissions) {
+    (void)counter;
+    emissions->n_changed++;
+    emissions->last_old = old_value;
+    emissions->last_new = new_value;
+}
+
+static void on_value_notify(GObject *object, GParamSpec *pspec, Emissions *emissions) {
+    (void)object; (void)pspec;
+    emissions->n_notified++;
+}
+
+static Counter* counter_new_watched(gint initial_value, Emissions *emissions) {
+    Counter *counter = counter_new("Test", initial_value, -100, 100, 1);
+    g_signal_connect(counter, "value-changed", G_CALLBACK(on_value_changed), emissions);
+    g_signal_connect(counter, "notify::value", G_CALLBACK(on_value_notify), emissions);
+    return counter;
+}
+
+// A single set is announced even when it keeps the value
+static void test_single_set_to_current_value(void) {
+    Emissions emissions = { 0 };
+    Counter *counter = counter_new_watched(5, &emissions);
+
+    g_assert_true(counter_set_value(counter, 5));
+    g_assert_cmpuint(emissions.n_changed, ==, 1);
+    g_assert_cmpuint(emissions.n_notified, ==, 1);
+    g_assert_cmpint(emissions.last_old, ==, 5);
+    g_assert_cmpint(emissions.last_new, ==, 5);
+
+    g_object_set(counter, "value", 5, NULL);
+    g_assert_cmpuint(emissions.n_changed, ==, 2);
+    g_assert_cmpuint(emissions.n_notified, ==, 2);
+
+    g_object_unref(counter);
+}
+
+static void test_reset_at_zero(void) {
+    Emissions emissions = { 0 };
+    Counter *counter = counter_new_watched(0, &emissions);
+
+    counter_reset(counter);
+    g_assert_cmpuint(emissions.n_changed, ==, 1);
+    g_assert_cmpint(emissions.last_old, ==, 0);
+    g_assert_cmpint(emissions.last_new, ==, 0);
+
+    g_object_unref(counter);
+}
+
+// Several changes that end on the starting value are dropped
+static void test_burst_cancelling_out(void) {
+    Emissions emissions = { 0 };
+    Counter *counter = counter_new_watched(0, &emissions);
+
+    counter_begin_update(counter);
+    counter_increment(counter);
+    counter_increment(counter);
+    counter_decrement(counter);
+    counter_decrement(counter);
+    counter_end_update(counter);
+    g_assert_cmpuint(emissions.n_changed, ==, 0);
+    g_assert_cmpuint(emissions.n_notified, ==, 0);
+
+    g_object_unref(counter);
+}
+
+static void test_burst_announced_once(void) {
+    Emissions emissions = { 0 };
+    Counter *counter = counter_new_watched(0, &emissions);
+
+    counter_begin_update(counter);
+    for (int i = 0; i < 6; i++) {
+        counter_increment(counter);
+    }
+    g_object_set(counter, "value", 7, NULL);
+    g_assert_cmpuint(emissions.n_changed, ==, 0);
+    g_assert_cmpuint(emissions.n_notified, ==, 0);
+    counter_end_update(counter);
+
+    g_assert_cmpuint(emissions.n_changed, ==, 1);
+    g_assert_cmpuint(emissions.n_notified, ==, 1);
+    g_assert_cmpint(emissions.last_old, ==, 0);
+    g_assert_cmpint(emissions.last_new, ==, 7);
+
+    g_object_unref(counter);
+}
+
+int main(int argc, char *argv[]) {
+    g_test_init(&argc, &argv, NULL);
+
+    g_test_add_func("/counter/notify/single-set-to-current-value", test_single_set_to_current_value);
+    g_test_add_func("/counter/notify/reset-at-zero", test_reset_at_zero);
+    g_test_add_func("/counter/notify/burst-cancelling-out", test_burst_cancelling_out);
+    g_test_add_func("/counter/notify/burst-announced-once", test_burst_announced_once);
+
+    return g_test_run();
+}